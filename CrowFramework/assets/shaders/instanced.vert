@@ -0,0 +1,12 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aCell; // grid cell, per instance
+
+uniform vec2 uScale;
+
+void main()
+{
+    // grid cell -> NDC center (top-left origin, y goes down)
+    vec2 center = vec2(-1.0 + uScale.x * (aCell.x + 0.5), 1.0 - uScale.y * (aCell.y + 0.5));
+    gl_Position = vec4(aPos.xy * uScale + center, 0.0, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+/// C ABI of SnakeVecEnv, exported by the SnakeEnv shared library.
+/// - All buffers are caller-owned and written in place; the library never
+///   allocates after snake_env_create
+/// - Layouts (envs = count given to create):
+///     obs          uint8   [envs][SNAKE_ENV_PLANES][grid_h][grid_w]
+///                          planes: 0 body, 1 head, 2 food (one-hot)
+///     rewards      float   [envs]  +1 food, -1 death, 0 otherwise
+///     dones        uint8   [envs]  0 running, 1 terminated, 2 truncated
+///     final_scores int32   [envs]  score of games that ended, else -1 (optional)
+///     actions      uint8   [envs]  0 up, 1 down, 2 left, 3 right
+/// - snake_env_step resets finished games itself: their obs rows already
+///   show the next episode (seed + envs)
+/// - One handle per caller thread; threads > 1 steps shards in parallel
+///   inside the call
+///
+/// Typical use (e.g. numpy arrays through ctypes):
+///   env = snake_env_create(4096, 32, 18, 8, 0);
+///   snake_env_set_buffers(env, obs, rewards, dones, NULL);
+///   snake_env_reset(env, seeds);
+///   for (...) snake_env_step(env, actions);
+///   snake_env_destroy(env);
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(SNAKE_ENV_STATIC)
+	#define SNAKE_ENV_API
+#elif defined(_WIN32)
+	#if defined(SNAKE_ENV_EXPORTS)
+		#define SNAKE_ENV_API __declspec(dllexport)
+	#else
+		#define SNAKE_ENV_API __declspec(dllimport)
+	#endif
+#else
+	#define SNAKE_ENV_API __attribute__((visibility("default")))
+#endif
+
+#define SNAKE_ENV_ABI_VERSION 1
+#define SNAKE_ENV_PLANES 3
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SnakeEnv SnakeEnv;
+
+/// Returns SNAKE_ENV_ABI_VERSION of the loaded library.
+SNAKE_ENV_API int snake_env_abi_version(void);
+
+/// NULL on bad arguments (envs < 1, grid_w < 4, grid_h < 2) or out of memory.
+/// threads <= 1 steps on the calling thread; starve_steps 0 = grid_w * grid_h * 4.
+SNAKE_ENV_API SnakeEnv* snake_env_create(int envs, int grid_w, int grid_h, int threads, int starve_steps);
+SNAKE_ENV_API void snake_env_destroy(SnakeEnv* env);
+
+/// Bytes of observation per env (SNAKE_ENV_PLANES * grid_w * grid_h).
+SNAKE_ENV_API size_t snake_env_obs_size(const SnakeEnv* env);
+
+/// Must be called before reset/step, and again if the buffers move.
+SNAKE_ENV_API void snake_env_set_buffers(SnakeEnv* env, uint8_t* obs, float* rewards, uint8_t* dones,
+	int32_t* final_scores);
+
+SNAKE_ENV_API void snake_env_reset(SnakeEnv* env, const uint64_t* seeds);
+SNAKE_ENV_API void snake_env_step(SnakeEnv* env, const uint8_t* actions);
+
+#ifdef __cplusplus
+}
+#endif
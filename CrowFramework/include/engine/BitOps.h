@@ -0,0 +1,63 @@
+#pragma once
+#include <engine/CpuFeatures.h>
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(CROW_ARCH_X86)
+#include <immintrin.h>
+#endif
+
+/// Small portable bit helpers (popcount / tzcnt / select).
+/// - Intrinsics where the compiler has them, plain C++ otherwise
+/// - SelectBit64Bmi2 must only be called when GetCpuFeatures().bmi2 is set
+
+inline int PopCount64(uint64_t v)
+{
+#if defined(_MSC_VER) && defined(CROW_ARCH_X64)
+	return int(__popcnt64(v));
+#elif defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcountll(v);
+#else
+	v = v - ((v >> 1) & 0x5555555555555555ull);
+	v = (v & 0x3333333333333333ull) + ((v >> 2) & 0x3333333333333333ull);
+	v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+	return int((v * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+// v must be non-zero
+inline int CountTrailingZeros64(uint64_t v)
+{
+#if defined(_MSC_VER) && defined(CROW_ARCH_X64)
+	unsigned long idx;
+	_BitScanForward64(&idx, v);
+	return int(idx);
+#elif defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(v);
+#else
+	int n = 0;
+	while (!(v & 1)) { v >>= 1; ++n; }
+	return n;
+#endif
+}
+
+// Position of the k-th (0-based) set bit of v; k < PopCount64(v)
+inline int SelectBit64(uint64_t v, int k)
+{
+	for (int i = 0; i < k; ++i)
+		v &= v - 1; // drop lowest set bit
+
+	return CountTrailingZeros64(v);
+}
+
+#if defined(CROW_ARCH_X64)
+// Same as SelectBit64 in two instructions: deposit bit k onto v's set bits
+CROW_TARGET("bmi,bmi2")
+inline int SelectBit64Bmi2(uint64_t v, int k)
+{
+	return int(_tzcnt_u64(_pdep_u64(uint64_t(1) << k, v)));
+}
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+
+/// Runtime CPU feature detection for optional SIMD / bit-manipulation paths.
+/// - Queried once (cpuid + xgetbv), cached afterwards
+/// - Code using these paths must keep a portable fallback
+struct CpuFeatures
+{
+	bool popcnt = false;
+	bool bmi2 = false;
+	bool avx2 = false;
+};
+
+const CpuFeatures& GetCpuFeatures();
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define CROW_ARCH_X86 1
+#endif
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define CROW_ARCH_X64 1
+#endif
+
+// Lets GCC/Clang emit ISA-specific code in one function without global flags.
+// MSVC allows intrinsics anywhere, so it needs nothing.
+#if defined(__GNUC__) || defined(__clang__)
+#define CROW_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CROW_TARGET(isa)
+#endif
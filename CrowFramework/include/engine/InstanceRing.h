@@ -0,0 +1,40 @@
+#pragma once
+
+#include <glad/glad.h>
+
+/// Ring of per-instance grid cells on the GPU, one quad drawn per cell.
+/// - Mirrors a SnakeBody: PushFront/PopBack touch one slot, so a step
+///   uploads 8 bytes instead of the whole body
+/// - Attribute 0 is the quad from the caller's VBO, attribute 1 the cell
+///   (vec2 per instance, see assets/shaders/instanced.vert)
+/// - Draw() is one instanced draw per contiguous run, at most two
+class InstanceRing
+{
+public:
+	InstanceRing() = default;
+	~InstanceRing();
+
+	InstanceRing(const InstanceRing&) = delete;
+	InstanceRing& operator=(const InstanceRing&) = delete;
+
+	/// quadVbo: 6 vec3 vertices. capacity: most cells ever held.
+	void Init(GLuint quadVbo, int capacity);
+
+	/// Replace the contents with count cells, head first, as x, y pairs.
+	void Assign(const float* cells, int count);
+	void PushFront(float x, float y);
+	void PopBack();
+	void Clear();
+
+	void Draw();
+	int Size() const { return m_size; }
+
+private:
+	void Destroy();
+
+private:
+	GLuint m_vao = 0, m_vbo = 0;
+	int m_capacity = 0;
+	int m_head = 0; // slot of the newest cell
+	int m_size = 0;
+};
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/// Read-only memory map of a whole file (MapViewOfFile / mmap).
+/// - Pages are loaded on first touch; readers use the bytes in place
+/// - An empty file opens with GetSize() == 0 and no mapping
+/// - Const after Open: safe to read from any thread
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const char* path);
+	void Close();
+
+	bool IsOpen() const { return m_open; }
+	const uint8_t* GetData() const { return m_data; }
+	size_t GetSize() const { return m_size; }
+
+private:
+	const uint8_t* m_data = nullptr;
+	size_t m_size = 0;
+	bool m_open = false;
+	void* m_mapping = nullptr; // Windows mapping handle
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Fixed-size thread pool with per-worker task deques and work stealing.
+/// - Owner pushes/pops the back of its deque (LIFO, cache-warm)
+/// - Idle workers steal from the front of other deques (FIFO, big chunks)
+/// - Tasks may Submit() more tasks; they land on the current worker's deque
+/// - Wait() blocks until every submitted task (and its children) has run,
+///   other callers' tasks included; from inside a task it would wait on
+///   itself, so Wait() and ParallelFor() are for threads outside the pool
+class WorkStealingPool
+{
+public:
+	using Task = std::function<void(int worker)>;
+
+	explicit WorkStealingPool(int threadCount = 0); // 0 = hardware threads
+	~WorkStealingPool();
+
+	WorkStealingPool(const WorkStealingPool&) = delete;
+	WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+	int GetThreadCount() const { return int(m_workers.size()); }
+
+	void Submit(Task task);
+	void Wait(); // not from a pool task (asserts): it would deadlock
+
+	/// Split [begin, end) lazily: each task halves its range and pushes the
+	/// upper half for thieves until the range is <= grain.
+	/// fn(begin, end, worker) runs on pool threads; blocks until the pool is
+	/// idle (Wait), so like Wait it must not be called from a pool task.
+	template <typename Fn>
+	void ParallelFor(int64_t begin, int64_t end, int64_t grain, Fn fn);
+
+	/// Index of the pool worker running the caller, -1 outside the pool.
+	int CurrentWorker() const;
+
+	static int HardwareThreads();
+
+private:
+	struct alignas(64) Worker
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+		std::thread thread;
+	};
+
+	void WorkerLoop(int index);
+	bool PopLocal(int index, Task& out);
+	bool Steal(int thief, Task& out);
+	void Push(int index, Task&& task);
+
+	template <typename Fn>
+	void SplitRange(int64_t begin, int64_t end, int64_t grain, const std::shared_ptr<Fn>& fn);
+
+private:
+	std::vector<std::unique_ptr<Worker>> m_workers;
+	std::atomic<int64_t> m_queued;   // tasks sitting in deques
+	std::atomic<int64_t> m_pending;  // submitted but not finished
+	std::atomic<uint32_t> m_nextQueue;
+	std::atomic<bool> m_stop;
+
+	std::mutex m_sleepMutex;
+	std::condition_variable m_wake;   // workers: new task / stop
+	std::condition_variable m_idle;   // Wait(): pending reached zero
+};
+
+template <typename Fn>
+void WorkStealingPool::ParallelFor(int64_t begin, int64_t end, int64_t grain, Fn fn)
+{
+	if (begin >= end) return;
+	if (grain < 1) grain = 1;
+
+	auto shared = std::make_shared<Fn>(std::move(fn));
+
+	// One seed task per worker so every deque starts with work
+	const int64_t n = GetThreadCount();
+	const int64_t span = (end - begin + n - 1) / n;
+	for (int64_t b = begin; b < end; b += span)
+	{
+		const int64_t e = b + span < end ? b + span : end;
+		Submit([this, b, e, grain, shared](int) { SplitRange(b, e, grain, shared); });
+	}
+
+	Wait();
+}
+
+template <typename Fn>
+void WorkStealingPool::SplitRange(int64_t begin, int64_t end, int64_t grain, const std::shared_ptr<Fn>& fn)
+{
+	while (end - begin > grain)
+	{
+		const int64_t mid = begin + (end - begin) / 2;
+		Submit([this, mid, end, grain, fn](int) { SplitRange(mid, end, grain, fn); });
+		end = mid;
+	}
+
+	(*fn)(begin, end, CurrentWorker());
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <game/SnakeTypes.h>
+#include <game/SnakeBody.h>
+#include <game/SnakeRng.h>
+
+#include <vector>
+#include <cstdint>
+
+/// SnakeGame variant storing occupancy as one uint64_t per row.
+/// - Same public API as SnakeGame, so both can run side by side
+/// - Grid width is limited to 64 columns
+/// - Food is the k-th free cell in row-major order (popcount per row,
+///   then PDEP/TZCNT inside the row), so food positions differ from
+///   SnakeGame's free-list order for the same seed
+class BitboardSnakeGame
+{
+public:
+	static constexpr int kMaxGridW = 64;
+
+	BitboardSnakeGame(int gridW, int gridH, uint64_t seed = SnakeRng::kDefaultSeed);
+	void Reset();
+	void Reset(uint64_t seed);
+	void Update(float dt);
+	void SetPendingDir(Dir d);
+	bool IsGameOver() const;
+	bool IsWon() const;
+
+	const Cell& GetHead() const;
+	BodySpans GetBody() const;
+	int GetLength() const;
+	const Cell& GetFood() const;
+	int GetGridW() const;
+	int GetGridH() const;
+	int GetScore() const;
+
+private:
+	void Step();
+	Cell NextHead() const;
+	bool IsOpposite(Dir a, Dir b) const;
+	bool HitsWall(const Cell& c) const;
+	bool HitsSelf(const Cell& c) const;
+	bool EatsFood(const Cell& c) const;
+	void SpawnFood();
+	void Occupy(const Cell& c);
+	void Release(const Cell& c);
+
+private:
+	int m_gridW, m_gridH;
+	uint64_t m_rowMask;          // low gridW bits set
+	std::vector<uint64_t> m_rows; // bit x of m_rows[y] = body at (x, y)
+	SnakeBody m_snake;
+	int m_freeCount;
+	Cell m_food;
+	Dir m_dir;
+	Dir m_pendingDir;
+	bool m_gameOver;
+	bool m_won;
+	float m_stepTime;
+	float m_acc;
+	uint64_t m_seed;
+	SnakeRng m_rng;
+};
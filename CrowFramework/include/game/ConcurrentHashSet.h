@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/// Insert-only set of 64-bit hashes shared by search threads without locks.
+/// - Open addressing, linear probing; a slot is claimed with one CAS
+/// - Keys are expected to be well mixed already (state hashes); 0 marks an
+///   empty slot, so key 0 is stored as 1
+/// - Never grows: past 3/4 load (or a long probe run) Add() reports Full
+///   and the caller decides what an incomplete search means
+class ConcurrentHashSet
+{
+public:
+	enum class AddResult { Added, Present, Full };
+
+	/// sizeLog2: the set has 2^sizeLog2 slots of 8 bytes.
+	explicit ConcurrentHashSet(int sizeLog2)
+		: m_mask((size_t(1) << sizeLog2) - 1),
+		m_limit((size_t(1) << sizeLog2) / 4 * 3),
+		m_keys(new std::atomic<uint64_t>[size_t(1) << sizeLog2]),
+		m_count(0)
+	{
+		Clear();
+	}
+
+	/// Not thread-safe: call between searches.
+	void Clear()
+	{
+		for (size_t i = 0; i <= m_mask; ++i)
+			m_keys[i].store(0, std::memory_order_relaxed);
+		m_count.store(0, std::memory_order_relaxed);
+	}
+
+	AddResult Add(uint64_t key)
+	{
+		if (key == 0) key = 1;
+
+		for (size_t probe = 0, i = size_t(key) & m_mask; probe < kMaxProbe; ++probe, i = (i + 1) & m_mask)
+		{
+			uint64_t seen = m_keys[i].load(std::memory_order_relaxed);
+			if (seen == key) return AddResult::Present;
+			if (seen != 0) continue;
+
+			if (m_count.load(std::memory_order_relaxed) >= m_limit)
+				return AddResult::Full;
+
+			// Lost the race: the winner may have stored this very key
+			if (m_keys[i].compare_exchange_strong(seen, key, std::memory_order_relaxed))
+			{
+				m_count.fetch_add(1, std::memory_order_relaxed);
+				return AddResult::Added;
+			}
+			if (seen == key) return AddResult::Present;
+		}
+		return AddResult::Full;
+	}
+
+	size_t GetCount() const { return m_count.load(std::memory_order_relaxed); }
+	size_t GetSlotCount() const { return m_mask + 1; }
+
+private:
+	static const size_t kMaxProbe = 256;
+
+	size_t m_mask;
+	size_t m_limit;
+	std::unique_ptr<std::atomic<uint64_t>[]> m_keys;
+	std::atomic<size_t> m_count;
+};
@@ -0,0 +1,242 @@
+#pragma once
+#include <game/SnakeTypes.h>
+#include <game/SnakeRng.h>
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+/// SnakeGame with the grid size as a compile-time parameter.
+/// - Same rules, API and food sequence as the runtime SnakeGame
+/// - Bounds checks, cell indexing and index -> (x, y) fold into constants
+///   (masks/shifts when W is a power of two)
+/// - All storage is std::array, no heap at all; for big boards allocate
+///   the object itself on the heap (it holds ~20 bytes per cell)
+/// - Use SnakeGame for sizes only known at run time
+template <int W, int H>
+class FixedSnakeGame
+{
+	static_assert(W >= 4 && H >= 1, "grid must fit the starting snake (tail at W / 2 - 2)");
+
+public:
+	static constexpr int kGridW = W;
+	static constexpr int kGridH = H;
+	static constexpr int kCells = W * H;
+
+	explicit FixedSnakeGame(uint64_t seed = SnakeRng::kDefaultSeed)
+		: m_seed(seed)
+	{
+		Reset();
+	}
+
+	void Reset(uint64_t seed)
+	{
+		m_seed = seed;
+		Reset();
+	}
+
+	void Reset()
+	{
+		m_rng.Seed(m_seed);
+		m_head = 0;
+		m_length = 0;
+		m_occupied.fill(0);
+		for (int i = 0; i < kCells; ++i)
+		{
+			m_freeCells[i] = Index(i);
+			m_freePos[i] = Index(i);
+		}
+		m_freeCount = kCells;
+		m_gameOver = false;
+		m_won = false;
+		m_acc = 0.0f;
+
+		m_dir = Dir::Right;
+		m_pendingDir = Dir::Right;
+
+		constexpr int cx = W / 2;
+		constexpr int cy = H / 2;
+
+		const Cell start[] = { { cx - 2, cy }, { cx - 1, cy }, { cx, cy } };
+		for (const Cell& part : start)
+		{
+			PushFront(part);
+			Occupy(part);
+		}
+
+		SpawnFood();
+	}
+
+	void Update(float dt)
+	{
+		if (m_gameOver) return;
+
+		m_acc += dt;
+
+		while (m_acc >= m_stepTime)
+		{
+			Step();
+			m_acc -= m_stepTime;
+		}
+	}
+
+	void SetPendingDir(Dir dir)
+	{
+		if (!IsOpposite(m_dir, dir))
+			m_pendingDir = dir;
+	}
+
+	bool IsGameOver() const { return m_gameOver; }
+	bool IsWon() const { return m_won; }
+
+	const Cell& GetHead() const { return m_body[m_head]; }
+	const Cell& GetFood() const { return m_food; }
+	int GetLength() const { return m_length; }
+	int GetScore() const { return m_length - 3; }
+	static constexpr int GetGridW() { return W; }
+	static constexpr int GetGridH() { return H; }
+
+	BodySpans GetBody() const
+	{
+		const int firstSize = (int(m_head) + m_length <= kBodyCap) ? m_length : kBodyCap - int(m_head);
+
+		BodySpans spans;
+		spans.first = { m_body.data() + m_head, firstSize };
+		spans.second = { m_body.data(), m_length - firstSize };
+		return spans;
+	}
+
+private:
+	static constexpr int RoundUpPow2(int v)
+	{
+		int p = 1;
+		while (p < v) p <<= 1;
+		return p;
+	}
+
+	static constexpr int kBodyCap = RoundUpPow2(kCells);
+	static constexpr unsigned kBodyMask = unsigned(kBodyCap - 1);
+
+	// Smallest integer type that can index every cell
+	using Index = std::conditional_t<(kCells <= 0xFFFF), uint16_t, int32_t>;
+	static constexpr Index kNoSlot = Index(~Index(0));
+
+	void Step()
+	{
+		m_dir = m_pendingDir;
+
+		Cell newHead = NextHead();
+
+		if (HitsWall(newHead) || HitsSelf(newHead))
+		{
+			m_gameOver = true;
+			return;
+		}
+
+		PushFront(newHead);
+		Occupy(newHead);
+
+		if (EatsFood(newHead))
+			SpawnFood();
+		else
+		{
+			Release(m_body[(m_head + unsigned(m_length) - 1) & kBodyMask]);
+			--m_length;
+		}
+	}
+
+	Cell NextHead() const
+	{
+		return Neighbor(m_body[m_head], m_dir);
+	}
+
+	static bool IsOpposite(Dir a, Dir b)
+	{
+		return (a == Dir::Up && b == Dir::Down) ||
+			(a == Dir::Down && b == Dir::Up) ||
+			(a == Dir::Left && b == Dir::Right) ||
+			(a == Dir::Right && b == Dir::Left);
+	}
+
+	static bool HitsWall(const Cell& c)
+	{
+		return unsigned(c.x) >= unsigned(W) || unsigned(c.y) >= unsigned(H);
+	}
+
+	bool HitsSelf(const Cell& c) const
+	{
+		return m_occupied[CellIndex(c)] != 0;
+	}
+
+	bool EatsFood(const Cell& c) const
+	{
+		return c.x == m_food.x && c.y == m_food.y;
+	}
+
+	void SpawnFood()
+	{
+		if (m_freeCount == 0)
+		{
+			m_gameOver = true;
+			m_won = true;
+			m_food = { -1, -1 };
+			return;
+		}
+
+		int slot = int(m_rng.NextBelow(uint32_t(m_freeCount)));
+		int idx = int(m_freeCells[slot]);
+
+		m_food = { idx % W, idx / W };
+	}
+
+	static int CellIndex(const Cell& c)
+	{
+		return c.y * W + c.x;
+	}
+
+	void PushFront(const Cell& c)
+	{
+		m_head = (m_head - 1) & kBodyMask;
+		m_body[m_head] = c;
+		++m_length;
+	}
+
+	void Occupy(const Cell& c)
+	{
+		int idx = CellIndex(c);
+		m_occupied[idx] = 1;
+
+		int slot = int(m_freePos[idx]);
+		Index last = m_freeCells[--m_freeCount];
+		m_freeCells[slot] = last;
+		m_freePos[last] = Index(slot);
+		m_freePos[idx] = kNoSlot;
+	}
+
+	void Release(const Cell& c)
+	{
+		int idx = CellIndex(c);
+		m_occupied[idx] = 0;
+
+		m_freeCells[m_freeCount] = Index(idx);
+		m_freePos[idx] = Index(m_freeCount++);
+	}
+
+private:
+	std::array<Cell, kBodyCap> m_body;
+	unsigned m_head = 0;
+	int m_length = 0;
+	std::array<uint8_t, kCells> m_occupied;
+	std::array<Index, kCells> m_freeCells;
+	std::array<Index, kCells> m_freePos;
+	int m_freeCount = 0;
+	Cell m_food = { -1, -1 };
+	Dir m_dir = Dir::Right;
+	Dir m_pendingDir = Dir::Right;
+	bool m_gameOver = false;
+	bool m_won = false;
+	float m_stepTime = 0.2f;
+	float m_acc = 0.0f;
+	uint64_t m_seed;
+	SnakeRng m_rng;
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <game/SnakeTypes.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class SnakeGame;
+
+/// Perfect-play controller: follow a Hamiltonian cycle, cut corners safely.
+/// - The cycle is a serpentine over the even dimension, built once per grid
+///   as flat order/successor tables for both directions; Prepare() (run on
+///   every Reset) picks the direction the starting body already lies along
+/// - Shortcut rule: with the body lying tail..head in cycle order, a move
+///   to any cell ahead of the head and before the tail lands on a free
+///   cell and keeps that ordering. Shortcuts never skip the food, leave
+///   more free cells before the tail than the snake is long and stop once
+///   it covers shortcutLimit of the board; after that it fills by pure cycle
+/// - Decide() is O(1): a few table lookups per neighbor
+///
+/// Grids need at least one even side (otherwise no Hamiltonian cycle exists).
+class HamiltonianSolver
+{
+public:
+	HamiltonianSolver(int gridW, int gridH, float shortcutLimit = 0.5f);
+
+	bool IsSupported() const { return m_supported; }
+
+	/// Choose the cycle direction for a freshly reset game. Decide() calls
+	/// it by itself when the game is not where it expects.
+	void Prepare(const SnakeGame& game);
+
+	Dir Decide(const SnakeGame& game);
+	void Drive(SnakeGame& game); // SetPendingDir(Decide(game))
+
+	/// Cycle position of a cell in the active direction.
+	int GetOrder(const Cell& c) const { return m_order[size_t(c.y * m_gridW + c.x)]; }
+
+private:
+	void BuildCycle();
+	int Ahead(int from, int to) const; // cycle steps from one cell to another
+
+private:
+	int m_gridW, m_gridH, m_cells;
+	bool m_supported;
+	int m_shortcutMax; // no shortcuts from this length on
+
+	// [0] = built direction, [1] = reversed
+	std::vector<int> m_orderTable[2];
+	std::vector<uint8_t> m_nextTable[2]; // Dir to the successor cell
+	const int* m_order;
+	const uint8_t* m_next;
+
+	// Bootstrap: body is in cycle order once the head has made
+	// length - 1 successor moves in a row
+	const SnakeGame* m_game;
+	int m_expectedHead; // cell index the head should be on next call, -1 = unknown
+	int m_run;
+	bool m_aligned;
+};
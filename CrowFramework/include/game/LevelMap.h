@@ -0,0 +1,71 @@
+#pragma once
+#include <engine/MappedFile.h>
+#include <game/SnakeTypes.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Precomputed BFS distances stored with a level, one uint16_t per cell.
+enum class LevelField
+{
+	FromSpawn, // steps from the spawn head around the walls
+	ToWall,    // steps to the nearest wall or border (1 = next to one)
+	kCount
+};
+
+/// Static wall layout for SnakeGame, memory-mapped and used in place.
+/// File, all little-endian (read zero-copy: little-endian hosts only):
+///   header   "SNLV", version, gridW u32, gridH u32, open cells u64,
+///            walls offset u64, fields offset u64, field count u32,
+///            reserved u32, payload FNV-1a u64, reserved u64 (64 bytes)
+///   walls    bit i of word i / 64 = cell i (row-major) is a wall
+///   fields   per LevelField, one uint16_t per cell, each padded to 8 bytes
+/// Build() keeps the SnakeGame spawn open (the three start cells and the
+/// one ahead) and walls in every pocket the spawn cannot reach, so food
+/// only lands where the snake can go.
+/// Const after Open: share one map across any number of games and threads.
+class LevelMap
+{
+public:
+	static constexpr uint16_t kUnreachable = 0xFFFF; // walls; distances saturate below it
+
+	/// Write a level: walls = one byte per cell, nonzero = wall.
+	static bool Build(const char* path, int gridW, int gridH, std::vector<uint8_t> walls);
+
+	/// Map path and check the header and the spawn cells: O(1), nothing
+	/// is copied. Files with a wall under the spawn are refused.
+	bool Open(const char* path);
+	void Close();
+
+	/// Recompute the payload hash (reads every byte; Open does not).
+	bool Verify() const;
+
+	int GetGridW() const { return m_gridW; }
+	int GetGridH() const { return m_gridH; }
+	uint64_t GetOpenCount() const { return m_openCount; }
+
+	/// (gridW * gridH + 63) / 64 words, inside the mapping.
+	const uint64_t* GetWalls() const { return m_walls; }
+	bool IsWall(const Cell& c) const
+	{
+		const size_t i = size_t(c.y) * size_t(m_gridW) + size_t(c.x);
+		return (m_walls[i >> 6] >> (i & 63)) & 1;
+	}
+
+	/// gridW * gridH distances, inside the mapping.
+	const uint16_t* GetField(LevelField f) const { return m_fields[size_t(f)]; }
+	uint16_t GetDistance(LevelField f, const Cell& c) const
+	{
+		return m_fields[size_t(f)][size_t(c.y) * size_t(m_gridW) + size_t(c.x)];
+	}
+
+	size_t GetFileSize() const { return m_file.GetSize(); }
+
+private:
+	MappedFile m_file;
+	int m_gridW = 0, m_gridH = 0;
+	uint64_t m_openCount = 0;
+	const uint64_t* m_walls = nullptr;
+	const uint16_t* m_fields[size_t(LevelField::kCount)] = {};
+};
@@ -0,0 +1,121 @@
+#pragma once
+#include <game/SnakeTypes.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Snake body stored as its head and tail cells plus a 2-bit direction
+/// chain, for holding very many paused or archived games at once.
+/// - Symbol i is the step from segment i to segment i + 1, counted from
+///   the tail; the chain is a ring of 32 symbols per uint64_t
+/// - PushFront/PopBack are O(1): push appends the step into the new head,
+///   pop moves the tail along the oldest step
+/// - 2 bits per segment against SnakeBody's 8 bytes: 32x smaller once the
+///   body outweighs the fixed fields
+/// - Same interface as SnakeBody where it can be; cells are decoded on
+///   demand (Decode, ForEach) instead of handed out as spans
+class PackedSnakeBody
+{
+public:
+	/// Reserve room for maxLength segments; the chain still grows past it.
+	void Init(int maxLength);
+
+	void Clear()
+	{
+		m_first = 0;
+		m_steps = 0;
+		m_size = 0;
+	}
+
+	/// c must be a 4-neighbour of Front() (any cell when empty).
+	void PushFront(const Cell& c)
+	{
+		if (m_size > 0)
+		{
+			if (m_words.empty() || unsigned(m_steps) > m_mask) Grow();
+			const unsigned p = (m_first + unsigned(m_steps)) & m_mask;
+			uint64_t& w = m_words[p >> 5];
+			const unsigned shift = (p & 31) * 2;
+			w = (w & ~(uint64_t(3) << shift)) | uint64_t(StepBetween(m_head, c)) << shift;
+			++m_steps;
+		}
+		else
+			m_tail = c;
+		m_head = c;
+		++m_size;
+	}
+
+	void PopBack()
+	{
+		if (--m_size == 0)
+		{
+			m_steps = 0;
+			return;
+		}
+		const unsigned d = unsigned(m_words[m_first >> 5] >> ((m_first & 31) * 2)) & 3;
+		m_tail.x += kDx[d];
+		m_tail.y += kDy[d];
+		m_first = (m_first + 1) & m_mask;
+		--m_steps;
+	}
+
+	/// Replace the contents with count cells, head first; consecutive
+	/// cells must be 4-neighbours (any snake body is).
+	void Assign(const Cell* cells, int count);
+
+	/// Write the body out head first; dst needs Size() cells.
+	void Decode(Cell* dst) const;
+
+	/// Call fn(cell) head to tail.
+	template <typename Fn>
+	void ForEach(Fn&& fn) const
+	{
+		if (m_size == 0) return;
+		Cell c = m_head;
+		fn(c);
+		for (int i = m_steps - 1; i >= 0; --i)
+		{
+			const unsigned d = StepAt(i);
+			c.x -= kDx[d];
+			c.y -= kDy[d];
+			fn(c);
+		}
+	}
+
+	const Cell& Front() const { return m_head; }
+	const Cell& Back() const { return m_tail; }
+	int Size() const { return m_size; }
+	int Capacity() const { return int(m_mask + 1) + 1; }
+
+	/// Bytes held, object included.
+	size_t GetMemoryBytes() const { return sizeof(*this) + m_words.capacity() * sizeof(uint64_t); }
+
+private:
+	static constexpr int kDx[4] = { 0, 0, -1, 1 }; // Dir order: Up, Down, Left, Right
+	static constexpr int kDy[4] = { -1, 1, 0, 0 };
+
+	static unsigned StepBetween(const Cell& from, const Cell& to)
+	{
+		if (to.y != from.y) return to.y < from.y ? unsigned(Dir::Up) : unsigned(Dir::Down);
+		return to.x < from.x ? unsigned(Dir::Left) : unsigned(Dir::Right);
+	}
+
+	// i-th step from the tail
+	unsigned StepAt(int i) const
+	{
+		const unsigned p = (m_first + unsigned(i)) & m_mask;
+		return unsigned(m_words[p >> 5] >> ((p & 31) * 2)) & 3;
+	}
+
+	void Grow();
+
+private:
+	std::vector<uint64_t> m_words;
+	unsigned m_mask = 0;  // step capacity - 1 (a power of two, >= 32)
+	unsigned m_first = 0; // ring position of the oldest step
+	int m_steps = 0;      // m_size - 1 once non-empty
+	int m_size = 0;
+	Cell m_head = { 0, 0 };
+	Cell m_tail = { 0, 0 };
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include <engine/MappedFile.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+class SnakeReplay;
+
+/// One game inside a mapped archive. packed points into the mapping:
+/// (steps + 3) / 4 bytes, 4 steps per byte (see SimulatePackedReplay).
+struct ArchivedGame
+{
+	uint64_t seed = 0;
+	uint64_t steps = 0;
+	int gridW = 0, gridH = 0;
+	int score = 0;
+	const uint8_t* packed = nullptr;
+};
+
+/// Replay archive file, all little-endian:
+///   header   "SNAR", version, 8 reserved bytes
+///   records  per game: "SNGM", gridW u16, gridH u16, seed u64, steps u64,
+///            score u32, FNV-1a of the record, then the 2-bit payload
+///            padded to 8 bytes
+///   index    u64 record offset per game: game i in O(1)
+///   footer   "SNIX", version, count u64, index offset u64, index hash u64
+/// Records only ever go after the last record; the index and footer are
+/// rewritten behind them on Commit. A crash before Commit leaves no valid
+/// footer at the end of the file, and readers rebuild the index by walking
+/// the records and keeping those whose hash and grid still check out.
+
+/// Sequential archive writer.
+class SnakeArchiveWriter
+{
+public:
+	SnakeArchiveWriter() = default;
+	~SnakeArchiveWriter();
+
+	SnakeArchiveWriter(const SnakeArchiveWriter&) = delete;
+	SnakeArchiveWriter& operator=(const SnakeArchiveWriter&) = delete;
+
+	/// Create path, or continue an existing archive (a torn tail is cut
+	/// back to the last intact record first).
+	bool Open(const char* path);
+
+	/// Append one finished game; score is what the game ended with.
+	/// False for grids SnakeGame cannot play (see IsPlayableGrid).
+	bool Append(const SnakeReplay& replay, int score);
+
+	/// Write the index and footer and flush: everything appended so far
+	/// is readable.
+	bool Commit();
+
+	/// Commit and close.
+	bool Close();
+
+	uint64_t GetCount() const { return uint64_t(m_offsets.size()); }
+
+private:
+	FILE* m_file = nullptr;
+	std::vector<uint64_t> m_offsets;
+	uint64_t m_end = 0;         // end of the last record
+	bool m_committed = true;
+	std::vector<uint8_t> m_buffer;
+};
+
+/// Memory-mapped archive reader; Get() is O(1) and copies nothing.
+/// Const after Open: any number of threads may read at once.
+class SnakeArchiveReader
+{
+public:
+	bool Open(const char* path);
+	void Close();
+
+	uint64_t GetCount() const { return m_count; }
+	/// Fields as stored; run CheckRecord before handing them to a game.
+	ArchivedGame Get(uint64_t i) const;
+
+	/// Recompute the record hash of game i and check its grid is playable.
+	bool CheckRecord(uint64_t i) const;
+
+	/// No valid footer: the index was rebuilt from the records.
+	bool WasRecovered() const { return m_recovered; }
+
+	/// File offset of game i's record.
+	uint64_t GetRecordOffset(uint64_t i) const;
+
+	/// End of the last intact record (where the next append goes).
+	uint64_t GetDataEnd() const { return m_dataEnd; }
+	size_t GetFileSize() const { return m_file.GetSize(); }
+
+private:
+	bool ReadFooter();
+	void Recover();
+
+private:
+	MappedFile m_file;
+	uint64_t m_count = 0;
+	uint64_t m_dataEnd = 0;
+	const uint8_t* m_index = nullptr;  // in the mapping, footer path
+	std::vector<uint64_t> m_offsets;   // recovered index
+	bool m_recovered = false;
+};
@@ -0,0 +1,95 @@
+#pragma once
+#include <game/SnakeTypes.h>
+#include <game/SnakeBody.h>
+#include <game/SnakeRng.h>
+
+#include <cstdint>
+#include <vector>
+
+class WorkStealingPool;
+
+/// Many snakes on one grid, all moving at once.
+/// - Collisions go through one shared occupancy index: a cell word holding
+///   0 (empty), snake id + 1, or a food tag. A move costs one lookup, no
+///   matter how many snakes there are
+/// - Bodies as they were at the start of a tick block every head, tails
+///   included (SnakeGame's rule for its own tail). Heads that reach the
+///   same cell all die (HeadOn); a head into a body dies (Self or Snake)
+/// - Dead snakes leave the board (length 0) and stay dead until Reset;
+///   a snake that found no room to spawn starts dead
+/// - Tick(pool) runs by region: moves are bucketed by the horizontal band
+///   of their target cell and each band resolves its own head-on claims
+///   in snake id order. Results do not depend on the thread count
+/// - Food is foodCount cells, refilled after each tick in snake id order
+class SnakeArena
+{
+public:
+	static constexpr int kBandRows = 16;
+
+	SnakeArena(int gridW, int gridH, int snakeCount, int foodCount, uint64_t seed = SnakeRng::kDefaultSeed);
+
+	void Reset();
+	void Reset(uint64_t seed);
+
+	/// Simultaneous move of every living snake; pool = nullptr runs inline.
+	void Tick(WorkStealingPool* pool = nullptr);
+
+	void SetPendingDir(int snake, Dir d);
+
+	int GetSnakeCount() const { return int(m_snakes.size()); }
+	int GetAliveCount() const { return m_aliveCount; }
+	bool IsAlive(int snake) const { return m_snakes[size_t(snake)].alive; }
+	DeathCause GetDeathCause(int snake) const { return m_snakes[size_t(snake)].cause; }
+	const Cell& GetHead(int snake) const { return m_snakes[size_t(snake)].body.Front(); }
+	BodySpans GetBody(int snake) const { return m_snakes[size_t(snake)].body.Spans(); }
+	int GetLength(int snake) const { return m_snakes[size_t(snake)].body.Size(); }
+	Dir GetDir(int snake) const { return m_snakes[size_t(snake)].dir; }
+	int GetScore(int snake) const { return m_snakes[size_t(snake)].score; }
+
+	/// Snake id on c, or -1 (empty, food or off the board).
+	int GetOwner(const Cell& c) const;
+	bool IsBlocked(const Cell& c) const; // wall or any body
+	const std::vector<Cell>& GetFood() const { return m_food; }
+	int GetGridW() const { return m_gridW; }
+	int GetGridH() const { return m_gridH; }
+	uint64_t GetTickCount() const { return m_tick; }
+
+private:
+	struct Snake
+	{
+		SnakeBody body;
+		Dir dir = Dir::Right;
+		Dir pendingDir = Dir::Right;
+		bool alive = false;
+		bool ate = false;
+		DeathCause cause = DeathCause::None;
+		int score = 0;
+		int target = -1; // cell index of this tick's move
+	};
+
+	static constexpr uint32_t kFoodTag = 0x80000000u; // | food index
+
+	int CellIndex(const Cell& c) const { return c.y * m_gridW + c.x; }
+	bool HitsWall(const Cell& c) const;
+	void Spawn(int id);
+	void SpawnFood(int slot);
+
+	void Move(int begin, int end);
+	void ResolveBand(int band);
+	void Apply(int begin, int end);
+
+private:
+	int m_gridW, m_gridH;
+	int m_bands;
+	std::vector<Snake> m_snakes;
+	std::vector<uint32_t> m_cells;       // occupancy index, see kFoodTag
+	std::vector<uint64_t> m_claims;      // tick << 32 | snake id, per cell
+	std::vector<Cell> m_food;
+	std::vector<int> m_bandStart;        // bands + 1 offsets into m_bandMoves
+	std::vector<int> m_bandMoves;        // living snake ids, bucketed by band
+	int m_aliveCount;
+	int64_t m_freeCount;
+	uint64_t m_tick;
+	uint64_t m_seed;
+	SnakeRng m_rng;
+};
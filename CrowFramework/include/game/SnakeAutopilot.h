@@ -0,0 +1,90 @@
+#pragma once
+#include <game/SnakeTypes.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class SnakeGame;
+class LevelMap;
+
+/// Built-in controller: shortest safe path to the food, else follow the tail.
+/// - BFS (unit-cost grid: A* would expand the same cells) that knows when
+///   each body segment leaves its cell, so paths may run through the tail
+/// - A path is taken only if, after eating, the head can still reach the
+///   tail of the resulting snake; otherwise it stalls on a tail-safe move
+/// - Every buffer is sized once for the grid: no allocation per decision
+/// - A safe food path is kept and replayed while the game follows it (same
+///   game, food and length, head where expected, next cell not blocked),
+///   so the full search runs about once per meal
+/// - Level walls are copied into the padded wall grid whenever the game's
+///   level changes, so the searches stay bounds- and bit-test-free
+///
+/// One instance per thread.
+class SnakeAutopilot
+{
+public:
+	SnakeAutopilot(int gridW, int gridH);
+
+	Dir Decide(const SnakeGame& game);
+	void Drive(SnakeGame& game); // SetPendingDir(Decide(game))
+
+private:
+	// Next step of the stored food path, if it still applies to game
+	bool FollowPlan(const SnakeGame& game, Dir& out);
+
+	// Rebuild m_wall for the game's level (border ring plus its walls)
+	void LoadWalls(const SnakeGame& game);
+
+	// Load the real body (head first) into m_body
+	void LoadBody(const SnakeGame& game);
+
+	// Stamp m_freeAt from m_body[0, length): segment k may be entered
+	// from step length - k + 1 on (the tail still blocks the first step)
+	void StampBody(int length);
+	bool Enterable(int cell, int step) const;
+
+	// Time-aware BFS from start over the stamped body. Stops at target and
+	// returns its distance (-1 = unreachable); target -1 floods everything
+	// and returns the number of cells reached.
+	int Search(int start, int target);
+
+	// Walk the BFS parents back from end into m_pathBuf; returns the length
+	int TracePath(int start, int end);
+
+	// After following the traced path to food: can the longer snake still
+	// reach its own tail?
+	bool SafeAfterEating(int steps, int length);
+
+	// Distance from head to tail after one move to next (-1 = trapped)
+	int TailDistanceAfter(int next, int length, bool eats);
+
+	int Pad(int x, int y) const { return (y + 1) * m_stride + (x + 1); }
+
+private:
+	int m_gridW, m_gridH, m_cells;
+	int m_stride;                     // padded row length, walls all around
+
+	std::vector<int> m_body;          // scratch snake, head first
+	std::vector<int> m_pathBuf;       // food path / next virtual snake
+	std::vector<uint32_t> m_bodyMark; // == m_bodyStamp: cell holds a segment
+	std::vector<int> m_freeAt;        // step from which the segment's cell is enterable
+	std::vector<uint32_t> m_seenMark; // == m_seenStamp: visited this search
+	std::vector<int> m_dist;
+	std::vector<uint8_t> m_parent;    // Dir taken to enter the cell
+	std::vector<uint8_t> m_wall;      // border ring and m_level's walls
+	std::shared_ptr<const LevelMap> m_level;
+	std::vector<int> m_queue;         // ring buffer, power-of-two capacity
+	unsigned m_queueMask;
+	int m_offset[4];                  // cell delta per Dir
+
+	// Stored food path (see FollowPlan)
+	std::vector<uint8_t> m_planDirs;
+	int m_planPos, m_planSize;
+	int m_planHead;                   // padded cell the head should be on
+	Cell m_planFood;
+	int m_planLength;
+	const SnakeGame* m_planGame;
+	uint32_t m_bodyStamp;
+	uint32_t m_seenStamp;
+};
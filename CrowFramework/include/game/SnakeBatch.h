@@ -0,0 +1,112 @@
+#pragma once
+#include <game/SnakeTypes.h>
+#include <game/SnakeRng.h>
+
+#include <vector>
+#include <cstdint>
+
+struct SnakeBatchKernelArgs;
+
+/// Which plan kernel SnakeBatch::Step uses.
+/// - Auto picks AVX2 when the CPU supports it
+enum class SnakeBatchKernel
+{
+	Auto, Scalar, Avx2
+};
+
+/// Headless engine stepping many SnakeGame-rule games in lockstep.
+/// - Structure-of-arrays: per-field arrays indexed by game
+/// - Per-game blocks (body ring, occupancy, free-cell set) live in one
+///   allocation each, game i at offset i * stride
+/// - Step() follows SnakeGame::SetPendingDir + Step exactly, including the
+///   free-list order, so a single game can be cross-checked
+/// - Finished games are frozen until Reset(i)
+/// - Step = vectorizable plan pass (next head, wall/self/food tests for
+///   8 games per AVX2 iteration) + scalar commit of body/free-list updates
+class SnakeBatch
+{
+public:
+	SnakeBatch(int count, int gridW, int gridH);
+
+	void Reset(int game, uint64_t seed);
+	void ResetAll(const uint64_t* seeds);
+
+	/// Advance every live game by one step.
+	/// - actions: one Dir per game (nullptr = keep pending directions)
+	/// - done: 1 once the game is over (dead or won), may be nullptr
+	/// - rewards: +1 food, -1 death, 0 otherwise, may be nullptr
+	void Step(const Dir* actions, uint8_t* done, float* rewards);
+
+	/// Select the plan kernel; unsupported choices fall back to Scalar.
+	void SetKernel(SnakeBatchKernel kernel);
+	SnakeBatchKernel GetKernel() const { return m_kernel; }
+
+	int GetCount() const { return m_count; }
+	int GetGridW() const { return m_gridW; }
+	int GetGridH() const { return m_gridH; }
+
+	bool IsGameOver(int game) const;
+	bool IsWon(int game) const;
+	int GetLength(int game) const;
+	int GetScore(int game) const;
+	Cell GetHead(int game) const;
+	Cell GetFood(int game) const;
+	Dir GetDir(int game) const;
+	BodySpans GetBody(int game) const;
+	const uint8_t* GetOccupancy(int game) const;
+
+	// Raw SoA views for batch consumers (policies, observation writers)
+	const int32_t* GetHeadXs() const { return m_headX.data(); }
+	const int32_t* GetHeadYs() const { return m_headY.data(); }
+	const int32_t* GetDirs() const { return m_dir.data(); }
+
+private:
+	enum State : uint8_t { Alive = 0, Dead = 1, Won = 2 };
+
+	// Base pointers of one game's blocks, computed once per game update
+	struct GameBlocks
+	{
+		Cell* body;
+		uint8_t* occupied;
+		int32_t* freeCells;
+		int32_t* freePos;
+	};
+
+	GameBlocks Blocks(int game);
+	void CommitAll(uint8_t* done, float* rewards);
+	void PushFront(int game, const GameBlocks& b, int x, int y);
+	void Occupy(int game, const GameBlocks& b, int cell);
+	void SpawnFood(int game, const GameBlocks& b);
+
+private:
+	int m_count;
+	int m_gridW, m_gridH;
+	int m_cells;       // gridW * gridH
+	int m_bodyCap;     // power of two >= m_cells
+	int m_bodyStride;  // m_bodyCap + one cache line, avoids power-of-two aliasing
+	int m_occStride;   // m_cells rounded up, keeps per-game rows aligned
+
+	// Per-game scalars
+	std::vector<int32_t> m_headX, m_headY;
+	std::vector<int32_t> m_dir, m_pendingDir;
+	std::vector<int32_t> m_foodCell;   // y * gridW + x, -1 when none
+	std::vector<int32_t> m_length;
+	std::vector<uint32_t> m_bodyHead;
+	std::vector<int32_t> m_freeCount;
+	std::vector<SnakeRng> m_rng;
+	std::vector<uint8_t> m_state;
+
+	// Plan pass output
+	std::vector<int32_t> m_nextX, m_nextY;
+	std::vector<int32_t> m_outcome;
+
+	using PlanFn = void (*)(const SnakeBatchKernelArgs&, int, int);
+	SnakeBatchKernel m_kernel;
+	PlanFn m_plan;
+
+	// Per-game blocks
+	std::vector<Cell> m_body;          // count * m_bodyCap
+	std::vector<uint8_t> m_occupied;   // count * m_occStride (+ gather padding)
+	std::vector<int32_t> m_freeCells;  // count * m_cells
+	std::vector<int32_t> m_freePos;    // count * m_cells
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include <engine/CpuFeatures.h>
+
+#include <cstdint>
+
+/// Internal step kernels for SnakeBatch.
+/// - Plan pass only: apply actions, commit dir, compute the next head and
+///   classify the move; body/free-list updates stay scalar in SnakeBatch
+/// - Scalar and AVX2 versions must produce identical results
+
+enum SnakeStepOutcome : int32_t
+{
+	StepSkip = 0, // game already over
+	StepMove = 1,
+	StepEat = 2,
+	StepDie = 3
+};
+
+struct SnakeBatchKernelArgs
+{
+	int count;
+	int gridW, gridH;
+	int occStride;
+
+	const int32_t* actions;    // may be nullptr
+	const uint8_t* state;      // 0 = alive
+	int32_t* dir;
+	int32_t* pendingDir;
+	const int32_t* headX;
+	const int32_t* headY;
+	const int32_t* foodCell;
+	const uint8_t* occupied;   // padded so 4-byte gathers stay in bounds
+
+	int32_t* nextX;
+	int32_t* nextY;
+	int32_t* outcome;
+};
+
+void PlanStepScalar(const SnakeBatchKernelArgs& args, int begin, int end);
+#if defined(CROW_ARCH_X86)
+void PlanStepAvx2(const SnakeBatchKernelArgs& args, int begin, int end);
+#endif
@@ -0,0 +1,98 @@
+#pragma once
+#include <game/SnakeTypes.h>
+
+#include <cstring>
+#include <vector>
+
+/// Fixed-capacity ring buffer holding the snake body.
+/// - Capacity is a power of two, so wrapping is a mask
+/// - Init() allocates once; Clear/PushFront/PopBack never allocate
+/// - Grow() doubles the capacity for bodies not sized for the whole board
+/// - Index 0 is the head, Size()-1 is the tail
+class SnakeBody
+{
+public:
+	void Init(int maxLength)
+	{
+		unsigned cap = 1;
+		while (cap < unsigned(maxLength)) cap <<= 1;
+
+		if (cap > m_cells.size())
+			m_cells.resize(cap);
+
+		m_mask = unsigned(m_cells.size()) - 1;
+		Clear();
+	}
+
+	void Clear()
+	{
+		m_head = 0;
+		m_size = 0;
+	}
+
+	/// Double the capacity, keeping the contents: the wrapped part of the
+	/// ring moves to the new upper half.
+	void Grow()
+	{
+		const unsigned cap = m_mask + 1;
+		if (m_cells.size() < size_t(cap) * 2)
+			m_cells.resize(size_t(cap) * 2);
+
+		const unsigned end = m_head + unsigned(m_size);
+		if (end > cap)
+			std::memcpy(m_cells.data() + cap, m_cells.data(), sizeof(Cell) * (end - cap));
+		m_mask = cap * 2 - 1;
+	}
+
+	void PushFront(const Cell& c)
+	{
+		m_head = (m_head - 1) & m_mask;
+		m_cells[m_head] = c;
+		++m_size;
+	}
+
+	void PopBack()
+	{
+		--m_size;
+	}
+
+	/// Replace the contents with count cells, head first (snapshot restore).
+	void Assign(const Cell* cells, int count)
+	{
+		m_head = 0;
+		m_size = count;
+		std::memcpy(m_cells.data(), cells, sizeof(Cell) * size_t(count));
+	}
+
+	/// Copy the body out head first; dst needs Size() cells.
+	void CopyTo(Cell* dst) const
+	{
+		const BodySpans spans = Spans();
+		std::memcpy(dst, spans.first.data, sizeof(Cell) * size_t(spans.first.size));
+		std::memcpy(dst + spans.first.size, spans.second.data, sizeof(Cell) * size_t(spans.second.size));
+	}
+
+	const Cell& Front() const { return m_cells[m_head]; }
+	const Cell& Back() const { return m_cells[(m_head + unsigned(m_size) - 1) & m_mask]; }
+	const Cell& operator[](int i) const { return m_cells[(m_head + unsigned(i)) & m_mask]; }
+
+	int Size() const { return m_size; }
+	int Capacity() const { return int(m_mask + 1); }
+
+	BodySpans Spans() const
+	{
+		const int cap = Capacity();
+		const int firstSize = (int(m_head) + m_size <= cap) ? m_size : cap - int(m_head);
+
+		BodySpans spans;
+		spans.first = { m_cells.data() + m_head, firstSize };
+		spans.second = { m_cells.data(), m_size - firstSize };
+		return spans;
+	}
+
+private:
+	std::vector<Cell> m_cells;
+	unsigned m_mask = 0;
+	unsigned m_head = 0;
+	int m_size = 0;
+};
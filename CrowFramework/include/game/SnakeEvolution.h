@@ -0,0 +1,98 @@
+#pragma once
+#include <game/SnakeMlp.h>
+#include <game/SnakeRng.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class SnakeGame;
+class WorkStealingPool;
+
+struct EvolutionConfig
+{
+	int population = 256;
+	int gamesPerGenome = 4;      // fitness = mean over these (fresh seeds each generation)
+	int elite = 8;               // best genomes carried over unchanged
+	int tournament = 4;
+	float mutationRate = 0.05f;  // chance per gene
+	float mutationSigma = 0.3f;
+	int gridW = 16, gridH = 16;  // features do not depend on the grid size
+	int starveSteps = 0;         // 0 = gridW * gridH
+	uint64_t seed = 1;
+};
+
+struct GenerationStats
+{
+	int generation = 0;
+	float bestFitness = 0.0f;
+	float meanFitness = 0.0f;
+	float bestScore = 0.0f;  // mean score of the best genome
+	int maxScore = 0;        // best single game
+	int64_t steps = 0;       // game steps simulated
+	double seconds = 0.0;
+};
+
+/// Genetic algorithm over SnakeMlp genomes.
+/// - Every genome plays the same gamesPerGenome seeds of a generation, all
+///   in lockstep: one batched Forward per step for the games still alive
+/// - Fitness: score + steps / (steps + cells) per game, so surviving
+///   counts until the first meal and never outweighs one
+/// - Genomes are spread over the pool; each worker owns its games, network
+///   and buffers (sized at construction), so evaluation never allocates
+/// - Breeding is serial: elites, then tournament pairs with uniform
+///   crossover and Gaussian mutation. Results do not depend on the
+///   thread count.
+class SnakeEvolution
+{
+public:
+	SnakeEvolution(WorkStealingPool& pool, const EvolutionConfig& config = EvolutionConfig());
+	~SnakeEvolution();
+
+	/// Evaluate the current population, then breed the next one.
+	const GenerationStats& RunGeneration();
+
+	/// Best genome of the last evaluated generation (SnakeMlp params).
+	const std::vector<float>& GetBest() const { return m_best; }
+	const GenerationStats& GetLastStats() const { return m_stats; }
+
+	void SetKernel(SnakeMlpKernel kernel);
+
+private:
+	struct Worker
+	{
+		std::vector<std::unique_ptr<SnakeGame>> games;
+		SnakeMlp mlp;
+		SnakeMlpScratch scratch;
+		std::vector<float> scores;
+		std::vector<int> live, hungry, steps, lastLength;
+		int64_t totalSteps = 0;
+		int maxScore = 0;
+
+		explicit Worker(int games);
+	};
+
+	void Evaluate(int genome, Worker& w);
+	void Breed(const std::vector<int>& ranked);
+	int Tournament(const std::vector<int>& rank);
+	float Gaussian();
+
+	float* Genome(int i) { return m_population.data() + size_t(i) * size_t(m_params); }
+
+private:
+	WorkStealingPool& m_pool;
+	EvolutionConfig m_config;
+	int m_params;
+	int m_cells;
+	int m_starveSteps;
+
+	std::vector<float> m_population, m_next; // population * m_params
+	std::vector<float> m_fitness;
+	std::vector<float> m_meanScore;
+	std::vector<float> m_best;
+	uint64_t m_generationSeed;
+
+	std::vector<std::unique_ptr<Worker>> m_workers;
+	SnakeRng m_rng;
+	GenerationStats m_stats;
+};
@@ -1,49 +1,114 @@
 #pragma once
-#include <deque>
+#include <game/SnakeTypes.h>
+#include <game/SnakeBody.h>
+#include <game/SnakeRng.h>
 
-struct Cell
-{
-	int x; int y;
-};
+#include <vector>
+#include <memory>
+#include <cstdint>
 
-enum class Dir 
-{
-	Up, Down, Left, Right
-};
+class SnakeReplay;
+class LevelMap;
 
 class SnakeGame
 {
 public:
-	SnakeGame(int gridW, int gridH);
-	void Reset();
-	void Update(float dt);
+	// Same (seed, inputs) = same game, bit for bit
+	SnakeGame(int gridW, int gridH, uint64_t seed = SnakeRng::kDefaultSeed);
+	// Grid size and walls from level (see SetLevel)
+	SnakeGame(std::shared_ptr<const LevelMap> level, uint64_t seed = SnakeRng::kDefaultSeed);
+	void Reset();              // replay from the current seed
+	void Reset(uint64_t seed); // start a new seed
+	// Steps of this call, see StepEventList
+	const StepEventList& Update(float dt);
+	const StepEvent& Tick(); // exactly one fixed step, for headless drivers (flags 0 once over)
 	void SetPendingDir(Dir d);
 	bool IsGameOver() const;
+	bool IsWon() const;
+	DeathCause GetDeathCause() const;
 
 	const Cell& GetHead() const;
-	const std::deque<Cell>& GetBody() const;
+	const Cell& GetTail() const;
+	BodySpans GetBody() const;
+	int GetLength() const;
 	const Cell& GetFood() const;
+	Dir GetDir() const;
+	bool IsBlocked(const Cell& c) const; // wall or body
 	int GetGridW() const;
 	int GetGridH() const;
 	int GetScore() const;
+	uint64_t GetSeed() const;
+	float GetStepTime() const;
+
+	// Log every committed direction into replay, starting at the next Reset
+	// (nullptr stops recording). The replay must outlive the game.
+	void SetRecorder(SnakeReplay* replay);
+
+	// Static walls from a level with this grid size, then Reset (nullptr =
+	// open board). The map is only read, so one can back any number of
+	// games on any threads. False (and no change) on a size mismatch.
+	bool SetLevel(std::shared_ptr<const LevelMap> level);
+	const std::shared_ptr<const LevelMap>& GetLevel() const;
+
+	// Flat snapshot of the whole state (see SnakeSnapshot.h).
+	// - slot: GetSnapshotSize() bytes, 8-byte aligned
+	// - Restore only into a game with the same grid size and level; never allocates
+	size_t GetSnapshotSize() const;
+	void Save(void* slot) const;
+	void Restore(const void* slot);
+
+	// 64-bit Zobrist hash of (occupied cells, head, tail, dir, food), kept
+	// up to date in O(1) per step. Keys depend only on the grid size, so
+	// hashes agree across game instances and threads.
+	uint64_t GetHash() const;
+	uint64_t ComputeHash() const; // from scratch, O(cells), for checks
+
+	// Hash of everything the future depends on: body order, dir, food, RNG
+	// state and free-list order (which picks the next food cell). Equal
+	// values = same future for the same inputs, up to 64-bit collisions.
+	// O(cells), for exact search.
+	uint64_t ComputeStateHash() const;
 
 private:
-	void Step();
+	void Step(StepEvent& e);
 	Cell NextHead() const;
 	bool IsOpposite(Dir a, Dir b) const;
 	bool HitsWall(const Cell& c) const;
 	bool HitsSelf(const Cell& c) const;
 	bool EatsFood(const Cell& c) const;
 	void SpawnFood();
+	int CellIndex(const Cell& c) const;
+	void Occupy(const Cell& c);
+	void Release(const Cell& c);
+
+	enum ZobristKind { ZOccupied, ZHead, ZTail, ZFood };
+	uint64_t Key(ZobristKind kind, const Cell& c) const;
+	uint64_t DirKey(Dir d) const;
 
 private:
 	int m_gridW, m_gridH;
-	std::deque<Cell> m_snake;
+	const uint64_t* m_walls;         // 1 bit per cell: the level's, or m_noWalls'
+	SnakeBody m_snake;
+	std::vector<uint8_t> m_occupied; // 1 byte per cell, mirrors m_snake
+	std::vector<int> m_freeCells;    // dense list of empty cell indices
+	std::vector<int> m_freePos;      // cell index -> slot in m_freeCells (-1 = occupied)
+	int m_freeCount;
 	Cell m_food;
 	Dir m_dir;
 	Dir m_pendingDir;
 	bool m_gameOver;
+	bool m_won;
+	DeathCause m_deathCause;
 	float m_stepTime;
 	float m_acc;
-	unsigned m_rngSeed;
+	uint64_t m_seed;
+	SnakeRng m_rng;
+	SnakeReplay* m_recorder;
+	std::shared_ptr<const std::vector<uint64_t>> m_zobristKeys; // shared per grid size
+	const uint64_t* m_zobrist; // 4 dir keys, then [4 + cell * 4 + kind]
+	uint64_t m_hash;
+	StepEventList m_events;   // Update()'s records, written in place
+	StepEvent m_event;        // Tick()'s record
+	std::shared_ptr<const LevelMap> m_level;
+	std::shared_ptr<const std::vector<uint64_t>> m_noWalls; // all-zero bitset, shared per grid size
 };
@@ -0,0 +1,117 @@
+#pragma once
+#include <game/SnakeTypes.h>
+#include <game/SnakeRng.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class SnakeGame;
+class WorkStealingPool;
+
+struct MctsConfig
+{
+	float budget = 0.1f;      // seconds per decision
+	int maxNodes = 1 << 20;   // arena size; once full, rollouts start at the leaves
+	int rolloutSteps = 64;    // random playout length past the leaf
+	float exploration = 0.7f; // UCT constant
+	int virtualLoss = 3;      // visits booked on a path while a thread is on it
+	float discount = 0.95f;   // per-step weight of a meal in the reward
+	uint64_t seed = 1;        // rollout streams, one per worker
+};
+
+/// Counters for the last Decide().
+struct MctsStats
+{
+	uint64_t rollouts = 0;
+	int nodes = 0;
+	int maxDepth = 0;
+	double seconds = 0.0;
+
+	double RolloutsPerSec() const { return seconds > 0.0 ? double(rollouts) / seconds : 0.0; }
+};
+
+/// Tree-parallel Monte Carlo tree search over SnakeGame moves.
+/// - Every pool worker descends the shared tree, expands one leaf, plays a
+///   random rollout on its own game copy (snapshot restore, no allocation)
+///   and backs the reward up the path
+/// - Nodes come from one arena sized up front; a bump counter hands out
+///   four children (one per Dir) at a time, so the tree needs no locks and
+///   Decide() resets it in O(1)
+/// - Visits and values are atomics; a descending thread adds virtual loss
+///   to its path so the others spread out, and takes it back on backup
+/// - Rollouts copy the full game, food RNG included, so the tree sees the
+///   food spawns the real game will produce (the game is deterministic)
+///
+/// One instance per game; the pool may be shared with other work: Decide()
+/// waits only for its own tasks, and from inside a pool task it searches
+/// on the calling thread alone (waiting there could deadlock the pool).
+class SnakeMcts
+{
+public:
+	SnakeMcts(WorkStealingPool& pool, const SnakeGame& game, const MctsConfig& config = MctsConfig());
+	~SnakeMcts();
+
+	/// Search from game for config.budget seconds and return the most
+	/// visited move. Blocks the caller; the pool's threads do the work.
+	/// Not thread-safe: one Decide() at a time per instance.
+	Dir Decide(const SnakeGame& game);
+	void Drive(SnakeGame& game); // SetPendingDir(Decide(game))
+
+	void SetBudget(float seconds) { m_config.budget = seconds; }
+	const MctsStats& GetLastStats() const { return m_stats; }
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Node
+	{
+		std::atomic<int64_t> value;     // reward sum, kValueOne fixed point
+		std::atomic<int32_t> visits;    // includes virtual loss in flight
+		std::atomic<uint32_t> children; // 0 = leaf, else first of 4 (or a sentinel)
+	};
+
+	struct alignas(64) Worker
+	{
+		std::unique_ptr<SnakeGame> game;
+		SnakeRng rng;
+		std::vector<uint32_t> path;
+		uint64_t rollouts = 0;
+		int maxDepth = 0;
+	};
+
+	// Iterations until the deadline, on the calling pool thread
+	void Search(Worker& w, Clock::time_point deadline);
+
+	// Claim a leaf and hand it four fresh children; 0 if another thread
+	// got there first or the arena is full
+	uint32_t Expand(uint32_t node);
+
+	// UCT over the legal children (unvisited first, random order)
+	uint32_t SelectChild(uint32_t first, int parentVisits, Dir current, SnakeRng& rng) const;
+
+	// Play on from game for up to rolloutSteps; reward in [0, 1]. meals and
+	// weight carry the discounted food count from the tree part of the path
+	float Rollout(SnakeGame& game, SnakeRng& rng, int depth, float meals, float weight) const;
+
+private:
+	WorkStealingPool& m_pool;
+	MctsConfig m_config;
+	MctsStats m_stats;
+
+	std::unique_ptr<Node[]> m_nodes;
+	std::atomic<uint32_t> m_nodeCount;
+
+	std::vector<uint64_t> m_root; // snapshot of the game being searched
+	std::vector<std::unique_ptr<Worker>> m_workers;
+
+	// Decide()'s own tasks still running (pool Wait() would also wait on
+	// unrelated work)
+	std::mutex m_doneMutex;
+	std::condition_variable m_done;
+	int m_running = 0;
+};
@@ -0,0 +1,95 @@
+#pragma once
+#include <game/SnakeTypes.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class SnakeGame;
+
+/// Which dense-layer kernel SnakeMlp uses.
+/// - Auto picks AVX2 when the CPU supports it
+enum class SnakeMlpKernel
+{
+	Auto, Scalar, Avx2
+};
+
+/// Per-thread buffers for batched SnakeMlp::Forward. Sized once for
+/// maxBatch rows; nothing is allocated per call.
+struct SnakeMlpScratch
+{
+	explicit SnakeMlpScratch(int maxBatch = 1);
+
+	int maxBatch;
+	std::vector<float> features; // maxBatch * SnakeMlp::kInputs
+	std::vector<float> hidden1, hidden2, scores; // padded rows
+};
+
+/// Small MLP policy: kInputs -> kHidden (ReLU) -> kHidden (ReLU) -> 4 move
+/// scores, argmax = next Dir. A genome is the flat parameter vector.
+/// - Inputs: from the head along 8 rays, inverse distance to the wall, to
+///   the nearest body segment and whether the food lies on the ray; plus
+///   the current Dir one-hot. Independent of the grid size.
+/// - Weights are kept input-major with each output row padded to 8 floats,
+///   so one AVX2 pass adds input i times weight row i to 8 outputs at once
+/// - Forward runs a whole batch of feature rows (one per game)
+///
+/// Const during inference: one instance can serve every thread, each with
+/// its own SnakeMlpScratch.
+class SnakeMlp
+{
+public:
+	static const int kRays = 8;
+	static const int kInputs = kRays * 3 + 4;
+	static const int kHidden = 16;
+	static const int kOutputs = 4;
+
+	/// Number of floats in a genome.
+	static int GetParamCount();
+
+	SnakeMlp();
+	explicit SnakeMlp(const float* params);
+
+	/// Load a genome (GetParamCount() floats: per layer, weights
+	/// [input][output] then biases).
+	void SetParams(const float* params);
+	const std::vector<float>& GetParams() const { return m_params; }
+
+	/// Select the dense kernel; unsupported choices fall back to Scalar.
+	void SetKernel(SnakeMlpKernel kernel);
+	SnakeMlpKernel GetKernel() const { return m_kernel; }
+
+	/// Fill kInputs features for game's current state.
+	static void ComputeFeatures(const SnakeGame& game, float* out);
+
+	/// inputs: batch rows of kInputs floats -> scores: batch rows of kOutputs.
+	void Forward(const float* inputs, int batch, float* scores, SnakeMlpScratch& scratch) const;
+
+	/// Argmax of one score row.
+	static Dir PickDir(const float* scores);
+
+	Dir Decide(const SnakeGame& game, SnakeMlpScratch& scratch) const;
+	void Drive(SnakeGame& game, SnakeMlpScratch& scratch) const; // SetPendingDir(Decide(game))
+
+	/// Genome file: magic, version, layer sizes, params (little-endian).
+	bool Save(const char* path) const;
+	bool Load(const char* path);
+
+private:
+	struct Layer
+	{
+		int inputs, outputs, stride; // stride: outputs rounded up to 8
+		size_t weights, bias;        // offsets into m_packed
+	};
+
+	// out[b][o] = (relu) bias[o] + sum_i in[b][i] * w[i][o], rows of stride floats
+	using DenseFn = void (*)(const float* w, const float* bias, int inputs, int stride,
+		const float* in, int inStride, int batch, float* out, bool relu);
+
+private:
+	std::vector<float> m_params;  // genome as given
+	std::vector<float> m_packed;  // layers with padded output rows
+	Layer m_layers[3];
+	SnakeMlpKernel m_kernel;
+	DenseFn m_dense;
+};
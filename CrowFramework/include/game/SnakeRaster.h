@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class SnakeBatch;
+class WorkStealingPool;
+
+/// Which row kernel SnakeRaster uses.
+/// - Auto picks AVX2 when the CPU supports it
+enum class SnakeRasterKernel
+{
+	Auto, Scalar, Avx2
+};
+
+/// Gray levels per cell kind.
+struct SnakeRasterPalette
+{
+	uint8_t empty = 0;
+	uint8_t body = 128;
+	uint8_t food = 192;
+	uint8_t head = 255;
+};
+
+/// CPU rasterizer: SnakeBatch boards -> outW x outH uint8 images
+/// (nearest-neighbor, e.g. 32x18 -> 84x84 for pixel-based agents).
+/// - Column/row maps and per-chunk shuffle masks are built once per size
+/// - A source row is expanded 32 output bytes at a time with one byte
+///   shuffle from the occupancy row plus one palette lookup shuffle;
+///   output rows that repeat a source row are copied, not re-expanded
+/// - Head and food are patched in afterwards as small filled rectangles
+/// - Writes into caller-owned images, game i at i * GetImageSize()
+///
+/// Const after construction: one instance can serve every thread.
+class SnakeRaster
+{
+public:
+	SnakeRaster(int gridW, int gridH, int outW, int outH,
+		const SnakeRasterPalette& palette = SnakeRasterPalette());
+
+	/// Select the row kernel; unsupported choices fall back to Scalar.
+	void SetKernel(SnakeRasterKernel kernel);
+	SnakeRasterKernel GetKernel() const { return m_kernel; }
+
+	size_t GetImageSize() const { return size_t(m_outW) * size_t(m_outH); }
+
+	/// One game's image into dst (GetImageSize() bytes).
+	void Render(const SnakeBatch& batch, int game, uint8_t* dst) const;
+
+	/// Every game of the batch; with a pool, each game is drawn whole by
+	/// one thread.
+	void RenderAll(const SnakeBatch& batch, uint8_t* images, WorkStealingPool* pool = nullptr) const;
+
+private:
+	// Fill rows [y0, y1) x columns [x0, x1) of dst with value
+	void FillRect(uint8_t* dst, int x0, int x1, int y0, int y1, uint8_t value) const;
+
+private:
+	int m_gridW, m_gridH;
+	int m_outW, m_outH;
+	SnakeRasterPalette m_palette;
+	SnakeRasterKernel m_kernel;
+	bool m_useAvx2;
+
+	std::vector<int32_t> m_srcX;            // output column -> grid column
+	std::vector<int32_t> m_srcY;            // output row -> grid row
+	std::vector<int32_t> m_colBegin, m_colEnd; // grid column -> output columns
+	std::vector<int32_t> m_rowBegin, m_rowEnd; // grid row -> output rows
+
+	// 16-column chunks: output x start, grid column the shuffle reads
+	// from, and the shuffle mask (offsets from that column)
+	std::vector<int32_t> m_chunkX;
+	std::vector<int32_t> m_chunkBase;
+	std::vector<uint8_t> m_chunkMask;       // 16 bytes per chunk
+	bool m_chunksFit;                       // every chunk spans < 16 grid columns
+};
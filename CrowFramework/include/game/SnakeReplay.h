@@ -0,0 +1,103 @@
+#pragma once
+#include <game/SnakeTypes.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class SnakeGame;
+class LevelMap;
+
+/// Input log of one game: grid size, seed and every committed direction.
+/// - 2 bits per step, 32 steps per word (100k steps = 25 KB)
+/// - (grid, seed, directions) re-simulate the game bit for bit
+class SnakeReplay
+{
+public:
+	void Begin(int gridW, int gridH, uint64_t seed);
+	void Append(Dir d)
+	{
+		const uint64_t bit = (m_steps & 31) * 2;
+		if (bit == 0) m_words.push_back(0);
+		m_words.back() |= uint64_t(d) << bit;
+		m_steps++;
+	}
+
+	Dir GetDir(uint64_t step) const
+	{
+		return Dir((m_words[size_t(step >> 5)] >> ((step & 31) * 2)) & 3);
+	}
+
+	uint64_t GetStepCount() const { return m_steps; }
+	int GetGridW() const { return m_gridW; }
+	int GetGridH() const { return m_gridH; }
+	uint64_t GetSeed() const { return m_seed; }
+	const std::vector<uint64_t>& GetWords() const { return m_words; }
+
+	/// Payload bytes on disk (header excluded).
+	size_t GetPackedSize() const { return size_t((m_steps + 3) / 4); }
+
+	/// Little-endian file: "SNRP", version, grid, seed, step count, payload.
+	bool Save(const char* path) const;
+	bool Load(const char* path);
+
+private:
+	int m_gridW = 0;
+	int m_gridH = 0;
+	uint64_t m_seed = 0;
+	uint64_t m_steps = 0;
+	std::vector<uint64_t> m_words;
+};
+
+/// Final state of a headless re-simulation.
+struct SnakeReplayResult
+{
+	bool valid = false;      // every logged step was played and the log ends where the game does
+	uint64_t steps = 0;      // steps actually simulated
+	int score = 0;
+	int length = 0;
+	bool gameOver = false;
+	bool won = false;
+	DeathCause deathCause = DeathCause::None;
+};
+
+/// Re-simulate a replay at full CPU speed (no rendering, no frame pacing).
+/// A log that continues after the game ended, or grid/seed that do not
+/// fit, comes back with valid = false. The log does not name a level:
+/// pass the one the game was played on (nullptr = open board).
+SnakeReplayResult SimulateReplay(const SnakeReplay& replay, std::shared_ptr<const LevelMap> level = nullptr);
+
+/// Same, from a packed payload in place (e.g. a mapped SnakeArchive):
+/// (steps + 3) / 4 little-endian bytes, 4 steps per byte. Resets game to
+/// seed first, so one game per grid size can be reused; it must not be
+/// recording.
+SnakeReplayResult SimulatePackedReplay(SnakeGame& game, uint64_t seed, const uint8_t* packed, uint64_t steps);
+
+/// Plays a replay back in game time for the renderer.
+/// - speed scales the game's fixed step (1 = live pace)
+/// - the replay must outlive playback; level as for SimulateReplay
+class SnakeReplayPlayer
+{
+public:
+	SnakeReplayPlayer();
+	~SnakeReplayPlayer();
+
+	void Start(const SnakeReplay& replay, std::shared_ptr<const LevelMap> level = nullptr);
+	void Stop();
+	void Update(float dt, float speed);
+
+	bool IsPlaying() const { return m_replay != nullptr; }
+	bool IsFinished() const;
+	uint64_t GetStep() const { return m_step; }
+	const SnakeGame& GetGame() const { return *m_game; }
+
+private:
+	void Advance();
+
+private:
+	const SnakeReplay* m_replay = nullptr;
+	std::unique_ptr<SnakeGame> m_game;
+	uint64_t m_step = 0;
+	float m_acc = 0.0f;
+};
@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+
+/// xoshiro256** generator (Blackman & Vigna), seeded through splitmix64.
+/// - 256-bit state, period 2^256 - 1, good low bits
+/// - Jump() advances 2^128 draws: non-overlapping streams for workers
+/// - Plain POD, so copying a game copies its exact random future
+class SnakeRng
+{
+public:
+	/// Seed used by games constructed without one.
+	static constexpr uint64_t kDefaultSeed = 0x5EED5EED;
+
+	SnakeRng() { Seed(0); }
+	explicit SnakeRng(uint64_t seed) { Seed(seed); }
+
+	/// Stream `index` of a seed: Seed(seed) then Jump() index times.
+	static SnakeRng ForStream(uint64_t seed, uint32_t index)
+	{
+		SnakeRng rng(seed);
+		for (uint32_t i = 0; i < index; ++i)
+			rng.Jump();
+		return rng;
+	}
+
+	void Seed(uint64_t seed)
+	{
+		for (uint64_t& word : s)
+		{
+			// splitmix64: never yields an all-zero state
+			seed += 0x9E3779B97F4A7C15ull;
+			uint64_t z = seed;
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			word = z ^ (z >> 31);
+		}
+	}
+
+	uint64_t Next()
+	{
+		const uint64_t result = Rotl(s[1] * 5, 7) * 9;
+		const uint64_t t = s[1] << 17;
+
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3] = Rotl(s[3], 45);
+
+		return result;
+	}
+
+	/// Uniform in [0, n) for n < 2^32: one draw, multiply-shift on the top
+	/// 32 bits (bias <= n / 2^32, irrelevant for board sizes).
+	uint32_t NextBelow(uint32_t n)
+	{
+		return uint32_t(((Next() >> 32) * uint64_t(n)) >> 32);
+	}
+
+	/// Uniform float in [0, 1).
+	float NextFloat()
+	{
+		return float(Next() >> 40) * (1.0f / 16777216.0f);
+	}
+
+	void Jump()
+	{
+		static const uint64_t kJump[] = {
+			0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+			0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+		};
+
+		uint64_t t[4] = { 0, 0, 0, 0 };
+		for (uint64_t word : kJump)
+		{
+			for (int b = 0; b < 64; ++b)
+			{
+				if (word & (uint64_t(1) << b))
+					for (int i = 0; i < 4; ++i) t[i] ^= s[i];
+				Next();
+			}
+		}
+		for (int i = 0; i < 4; ++i) s[i] = t[i];
+	}
+
+	bool operator==(const SnakeRng& o) const
+	{
+		return s[0] == o.s[0] && s[1] == o.s[1] && s[2] == o.s[2] && s[3] == o.s[3];
+	}
+
+	uint64_t s[4];
+
+private:
+	static uint64_t Rotl(uint64_t x, int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+};
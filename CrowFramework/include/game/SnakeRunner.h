@@ -0,0 +1,58 @@
+#pragma once
+#include <game/SnakeGame.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+class WorkStealingPool;
+class LevelMap;
+
+/// How an evaluated episode ended.
+enum class EpisodeEnd
+{
+	Wall, Self, Won, Starved, Count
+};
+
+/// Policy callback: pick the next direction for a game.
+/// - rng: the episode's policy stream, a 2^128 jump away from the food stream
+/// - worker: pool thread index, so stateful policies can keep per-thread data
+/// Draw randomness only from rng and an episode replays identically on any
+/// thread count.
+using SnakePolicy = std::function<Dir(const SnakeGame& game, SnakeRng& rng, int worker)>;
+
+struct RunnerConfig
+{
+	int gridW = 32;
+	int gridH = 18;
+	uint64_t seedBegin = 0;  // one episode per seed in [seedBegin, seedEnd)
+	uint64_t seedEnd = 1000;
+	int starveSteps = 0;     // steps without food before giving up, 0 = gridW * gridH
+	int grain = 16;          // episodes per leaf task
+	std::shared_ptr<const LevelMap> level; // read by every worker's game, nullptr = open board; grid must match
+};
+
+/// Aggregated results; per-worker copies are merged at the end.
+struct RunnerStats
+{
+	uint64_t episodes = 0;
+	uint64_t steps = 0;
+	int64_t scoreSum = 0;
+	int64_t lengthSum = 0;
+	int scoreMin = 0;
+	int scoreMax = 0;
+	uint64_t ends[int(EpisodeEnd::Count)] = {};
+	double seconds = 0.0;
+
+	void Add(const SnakeGame& game, EpisodeEnd end, uint64_t episodeSteps);
+	void Merge(const RunnerStats& other);
+	double MeanScore() const { return episodes ? double(scoreSum) / double(episodes) : 0.0; }
+};
+
+/// Play one headless episode to the end with the given policy.
+EpisodeEnd RunEpisode(SnakeGame& game, uint64_t seed, const SnakePolicy& policy, int worker,
+	int starveSteps, uint64_t& steps);
+
+/// Play every seed of the range across the pool's threads. Empty stats
+/// (no episodes) if config.level does not match the grid.
+RunnerStats RunEpisodes(WorkStealingPool& pool, const RunnerConfig& config, const SnakePolicy& policy);
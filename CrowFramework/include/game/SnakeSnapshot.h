@@ -0,0 +1,65 @@
+#pragma once
+#include <game/SnakeTypes.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class SnakeGame;
+
+/// Fixed part of a SnakeGame snapshot; the board arrays follow it in the slot:
+///   freePos int[cells] | freeCells int[freeCount] | body Cell[length] | occupied uint8[cells]
+/// Plain bytes: slots can be memcpy'd, pooled or written to disk as-is.
+struct SnakeSnapshotHeader
+{
+	int32_t gridW, gridH;
+	int32_t length;
+	int32_t freeCount;
+	Cell food;
+	float acc;
+	uint8_t dir, pendingDir;
+	uint8_t gameOver, won, deathCause;
+	uint8_t pad[7]; // zeroed: equal states give equal bytes
+	uint64_t seed;
+	uint64_t rng[4];
+	uint64_t hash;
+};
+static_assert(sizeof(SnakeSnapshotHeader) == 88, "snapshot header must have no implicit padding");
+
+/// Stack of snapshot slots in one allocation, for depth-first search.
+/// - Slot size is fixed per grid (SnakeGame::GetSnapshotSize)
+/// - Push/Pop/Restore never allocate
+///
+/// Typical use:
+///   arena.Push(game); game.Tick(); ...; arena.Pop(game);
+class SnakeSnapshotArena
+{
+public:
+	SnakeSnapshotArena(const SnakeGame& game, int maxDepth);
+
+	/// Save game into the next slot. Returns false when the arena is full.
+	bool Push(const SnakeGame& game);
+
+	/// Restore the top slot into game and release it.
+	void Pop(SnakeGame& game);
+
+	/// Restore the top slot into game and keep it (siblings in a search).
+	void RestoreTop(SnakeGame& game) const;
+
+	/// Release the top slot without restoring.
+	void Drop() { --m_depth; }
+
+	void* Slot(int i) { return m_base + size_t(i) * m_slotSize; }
+	const void* Slot(int i) const { return m_base + size_t(i) * m_slotSize; }
+
+	int GetDepth() const { return m_depth; }
+	int GetMaxDepth() const { return m_maxDepth; }
+	size_t GetSlotSize() const { return m_slotSize; }
+
+private:
+	std::vector<uint64_t> m_storage; // 8-byte aligned slots
+	unsigned char* m_base;
+	size_t m_slotSize;
+	int m_maxDepth;
+	int m_depth;
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include <game/ConcurrentHashSet.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class SnakeGame;
+class SnakeSnapshotArena;
+class WorkStealingPool;
+
+struct SolveResult
+{
+	int maxScore = 0;     // best score over every reachable state
+	int maxPossible = 0;  // board full
+	bool proven = false;  // whole state space searched (or the board was filled)
+	uint64_t states = 0;  // distinct states visited
+	double seconds = 0.0;
+};
+
+/// Exact maximum score of a seeded game, for small grids (up to about 6x6).
+/// - The game is deterministic, so the score a state can still reach
+///   depends only on the state; the answer is the best score over every
+///   state reachable from the start
+/// - States are keyed by SnakeGame::ComputeStateHash() in one shared
+///   lock-free set: each is expanded once, whichever thread gets it first
+/// - Depth-first on per-worker snapshot stacks; a subtree moves to the
+///   pool as a new task while the pool is short of queued work, or when a
+///   stack runs full
+/// - Stops early once a filled board shows the maximum is reached
+///
+/// Mirror and rotation symmetry are not used: food lands on the free-list
+/// slot the RNG picks, and the free-list order does not mirror with the
+/// board, so mirrored states do not share futures.
+///
+/// A full set ends the search; the result is then a lower bound (proven
+/// stays false).
+class SnakeSolver
+{
+public:
+	/// memoLog2: the state set holds 2^memoLog2 hashes (8 bytes each).
+	SnakeSolver(WorkStealingPool& pool, int memoLog2 = 24);
+	~SnakeSolver();
+
+	SolveResult Solve(const SnakeGame& start);
+
+private:
+	struct alignas(64) Worker
+	{
+		std::unique_ptr<SnakeGame> game;
+		std::unique_ptr<SnakeSnapshotArena> stack;
+		uint64_t states = 0;
+	};
+
+	// Hand the subtree below game to the pool
+	void Spawn(const SnakeGame& game);
+
+	// Visit every unseen child of the state in w.game, depth-first
+	void Expand(Worker& w);
+
+	void Record(int score);
+
+private:
+	WorkStealingPool& m_pool;
+	ConcurrentHashSet m_memo;
+	std::vector<std::unique_ptr<Worker>> m_workers;
+
+	std::atomic<int> m_best;
+	std::atomic<int> m_queued; // spawned tasks not started yet
+	std::atomic<bool> m_stop;
+	std::atomic<bool> m_full;  // memo ran out of room
+	int m_maxPossible;
+};
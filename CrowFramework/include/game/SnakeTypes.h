@@ -0,0 +1,117 @@
+#pragma once
+#include <cstdint>
+
+struct Cell
+{
+	int x; int y;
+};
+
+enum class Dir 
+{
+	Up, Down, Left, Right
+};
+
+/// The cell n steps from c in direction d; may lie off the grid.
+inline Cell Neighbor(Cell c, Dir d, int n = 1)
+{
+	switch (d)
+	{
+	case Dir::Up:    c.y -= n; break;
+	case Dir::Down:  c.y += n; break;
+	case Dir::Left:  c.x -= n; break;
+	case Dir::Right: c.x += n; break;
+	}
+	return c;
+}
+
+/// Boards the dense SnakeGame-rule engines accept: Reset() puts the tail
+/// at gridW / 2 - 2, and the cap keeps corrupt headers and typos from
+/// allocating huge boards.
+inline bool IsPlayableGrid(int w, int h)
+{
+	return w >= 4 && h >= 1 && w <= 4096 && h <= 4096;
+}
+
+enum class DeathCause
+{
+	None, Wall, Self,
+	Snake, HeadOn // SnakeArena: another snake's body, two heads into one cell
+};
+
+/// Contiguous run of body cells (head-to-tail order).
+struct CellSpan
+{
+	const Cell* data;
+	int size;
+
+	const Cell* begin() const { return data; }
+	const Cell* end() const { return data + size; }
+};
+
+/// Snake body as at most two contiguous spans.
+/// - first starts at the head
+/// - second continues after the ring wraps (may be empty)
+struct BodySpans
+{
+	CellSpan first;
+	CellSpan second;
+
+	int Size() const { return first.size + second.size; }
+
+	template <typename Fn>
+	void ForEach(Fn&& fn) const
+	{
+		for (const Cell& c : first) fn(c);
+		for (const Cell& c : second) fn(c);
+	}
+};
+
+/// What one SnakeGame step changed: at most a new head, a freed tail and
+/// new food, so incremental consumers never rescan the body.
+struct StepEvent
+{
+	enum Flags : uint8_t
+	{
+		Moved = 1,     // added = new head
+		Grew = 2,      // ate: the tail stayed, removed is unset
+		FoodMoved = 4, // ate: food moved to a new cell
+		Won = 8,       // ate the last free cell: food is { -1, -1 }
+		Died = 16      // cause says why; nothing else changed
+	};
+
+	Cell added = { -1, -1 };
+	Cell removed = { -1, -1 }; // old tail
+	Cell food = { -1, -1 };    // food after the step
+	Dir dir = Dir::Right;      // direction committed this step
+	uint8_t flags = 0;
+	DeathCause cause = DeathCause::None;
+};
+
+/// Steps of one Update(), oldest first. A frame that runs more than
+/// kCapacity steps keeps the first ones and sets overflowed: rescan the
+/// state instead of applying the list.
+struct StepEventList
+{
+	static constexpr int kCapacity = 8;
+
+	int count = 0;
+	bool overflowed = false;
+	StepEvent events[kCapacity];
+
+	void Clear()
+	{
+		count = 0;
+		overflowed = false;
+	}
+
+	void Push(const StepEvent& e)
+	{
+		if (count < kCapacity)
+			events[count++] = e;
+		else
+			overflowed = true;
+	}
+
+	const StepEvent* begin() const { return events; }
+	const StepEvent* end() const { return events + count; }
+};
@@ -0,0 +1,87 @@
+#pragma once
+#include <game/SnakeBatch.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class WorkStealingPool;
+
+/// Batched RL environment: reset(seeds) / step(actions) over SnakeBatch
+/// (SnakeGame rules bit for bit, including food placement).
+/// - Every call writes straight into caller-owned buffers (see SetBuffers);
+///   nothing is allocated after construction
+/// - Observations: kPlanes one-hot uint8 planes per env, [env][plane][y][x].
+///   Step() only touches the cells that changed (old/new head, old tail,
+///   old/new food), so leave obs alone between calls; Reset() rewrites it
+/// - Finished games reset inside Step(): their reward/done describe the
+///   step that ended them, their obs already shows the next episode.
+///   Env i continues with seed + envs, so seeds base + i stay unique
+/// - Games are split into one SnakeBatch shard per thread; threads > 1
+///   runs the shards on an owned WorkStealingPool
+class SnakeVecEnv
+{
+public:
+	enum Plane { PlaneBody, PlaneHead, PlaneFood, kPlanes };
+
+	enum DoneFlag : uint8_t
+	{
+		Running = 0,
+		Terminated = 1, // dead or won
+		Truncated = 2   // starveSteps without food
+	};
+
+	/// starveSteps 0 = gridW * gridH * 4
+	SnakeVecEnv(int envs, int gridW, int gridH, int threads = 1, int starveSteps = 0);
+	~SnakeVecEnv();
+
+	/// obs: envs * GetObsSize() bytes; rewards, dones: envs entries.
+	/// finalScores (optional): score of each game that ended this step,
+	/// -1 for the others.
+	void SetBuffers(uint8_t* obs, float* rewards, uint8_t* dones, int32_t* finalScores = nullptr);
+
+	/// Start every env from its seed and write the full observations.
+	void Reset(const uint64_t* seeds);
+
+	/// actions: one Dir (0 Up, 1 Down, 2 Left, 3 Right) per env.
+	void Step(const uint8_t* actions);
+
+	int GetEnvCount() const { return m_envs; }
+	int GetGridW() const { return m_gridW; }
+	int GetGridH() const { return m_gridH; }
+	size_t GetObsSize() const { return size_t(kPlanes) * size_t(m_cells); } // bytes per env
+
+private:
+	struct Shard
+	{
+		std::unique_ptr<SnakeBatch> batch;
+		int begin, count;
+		std::vector<Dir> actions;
+
+		// Cells before the step, for the incremental obs update
+		std::vector<int32_t> head, tail, food, length;
+	};
+
+	void StepShard(Shard& shard, const uint8_t* actions);
+	void ResetEnv(Shard& shard, int local, uint64_t seed);
+	void WriteObs(const Shard& shard, int local);
+	static int TailCell(const SnakeBatch& batch, int game, int gridW);
+
+private:
+	int m_envs;
+	int m_gridW, m_gridH, m_cells;
+	int m_starveSteps;
+
+	std::vector<Shard> m_shards;
+	std::unique_ptr<WorkStealingPool> m_pool;
+
+	// Per env
+	std::vector<uint64_t> m_seed;     // seed of the running episode
+	std::vector<int32_t> m_hungry;    // steps since the last meal
+
+	uint8_t* m_obs;
+	float* m_rewards;
+	uint8_t* m_dones;
+	int32_t* m_finalScores;
+};
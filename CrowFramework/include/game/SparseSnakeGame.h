@@ -0,0 +1,108 @@
+#pragma once
+#include <game/SnakeTypes.h>
+#include <game/SnakeBody.h>
+#include <game/SnakeRng.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// SnakeGame variant for huge boards (4096x4096 and beyond).
+/// - Same public API and rules as SnakeGame; food positions differ for the
+///   same seed (see SpawnFood)
+/// - Occupancy lives in 64x64-cell bit tiles (512 bytes each), allocated
+///   when the snake enters them and released when its last segment
+///   leaves; a tile directory (4 bytes per tile slot) finds them in O(1)
+/// - The body ring grows by doubling with the snake instead of being
+///   sized for the board
+/// - Memory follows the area the snake covers: directory + tiles + body
+class SparseSnakeGame
+{
+public:
+	static constexpr int kTileShift = 6;
+	static constexpr int kTileSize = 1 << kTileShift;
+
+	// Largest side: cell coordinates and tile counts stay well inside int
+	// (the directory alone is (side / 64)^2 * 4 bytes, 1 GB here)
+	static constexpr int kMaxSide = 1 << 20;
+
+	/// gridW in [4, kMaxSide], gridH in [1, kMaxSide].
+	SparseSnakeGame(int gridW, int gridH, uint64_t seed = SnakeRng::kDefaultSeed);
+	~SparseSnakeGame();
+
+	void Reset();
+	void Reset(uint64_t seed);
+	void Update(float dt);
+	void Tick();
+	void SetPendingDir(Dir d);
+	bool IsGameOver() const;
+	bool IsWon() const;
+	DeathCause GetDeathCause() const;
+
+	const Cell& GetHead() const;
+	const Cell& GetTail() const;
+	BodySpans GetBody() const;
+	int GetLength() const;
+	const Cell& GetFood() const;
+	Dir GetDir() const;
+	bool IsBlocked(const Cell& c) const; // wall or body
+	int GetGridW() const;
+	int GetGridH() const;
+	int GetScore() const;
+	uint64_t GetSeed() const;
+	float GetStepTime() const;
+
+	/// Tiles currently allocated.
+	int GetTileCount() const { return m_liveTiles; }
+
+	/// Bytes held by the directory, tiles (live and spare) and body.
+	size_t GetMemoryBytes() const;
+
+private:
+	struct Tile
+	{
+		uint64_t rows[kTileSize]; // bit x of rows[y] = body at (x, y) in the tile
+		int count;
+	};
+
+	void Step();
+	Cell NextHead() const;
+	bool IsOpposite(Dir a, Dir b) const;
+	bool HitsWall(const Cell& c) const;
+	bool HitsSelf(const Cell& c) const;
+	bool EatsFood(const Cell& c) const;
+	void SpawnFood();
+	bool PickFreeCell(uint64_t k, Cell& out) const;
+	void PushFront(const Cell& c);
+	void Occupy(const Cell& c);
+	void Release(const Cell& c);
+
+	size_t TileIndex(const Cell& c) const
+	{
+		return size_t(c.y >> kTileShift) * size_t(m_tilesX) + size_t(c.x >> kTileShift);
+	}
+
+private:
+	int m_gridW, m_gridH;
+	int m_tilesX, m_tilesY;
+	uint64_t m_cells;
+
+	std::vector<uint32_t> m_directory;        // tile slot + 1, 0 = no tile
+	std::vector<std::unique_ptr<Tile>> m_tiles; // slots; null when free
+	std::vector<uint32_t> m_freeSlots;
+	std::vector<std::unique_ptr<Tile>> m_spare; // recently emptied, reused first
+	int m_liveTiles;
+
+	SnakeBody m_snake;
+	Cell m_food;
+	Dir m_dir;
+	Dir m_pendingDir;
+	bool m_gameOver;
+	bool m_won;
+	DeathCause m_deathCause;
+	float m_stepTime;
+	float m_acc;
+	uint64_t m_seed;
+	SnakeRng m_rng;
+};
@@ -0,0 +1,99 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/// What a search stored about a position.
+struct TTEntry
+{
+	int32_t value = 0;
+	int16_t depth = -1;     // remaining search depth the value was computed with
+	uint8_t bound = 0;      // caller-defined (exact / lower / upper)
+	uint8_t move = 0;       // best Dir found, as uint8_t
+};
+
+/// Fixed-size hash table keyed by SnakeGame::GetHash(), shared by search
+/// threads without locks.
+/// - One slot per index, two 64-bit words: (key ^ data, data)
+/// - Torn writes from racing threads fail the key check and read as a miss
+///   (Hyatt & Mann's lockless XOR scheme), so no entry is ever mixed up
+/// - Replacement: a different position always wins, the same position only
+///   when searched at least as deep
+class TranspositionTable
+{
+public:
+	/// sizeLog2: the table holds 2^sizeLog2 slots of 16 bytes.
+	explicit TranspositionTable(int sizeLog2)
+		: m_mask((size_t(1) << sizeLog2) - 1),
+		m_slots(new Slot[size_t(1) << sizeLog2])
+	{
+		Clear();
+	}
+
+	/// Not thread-safe: call between searches.
+	void Clear()
+	{
+		for (size_t i = 0; i <= m_mask; ++i)
+		{
+			m_slots[i].check.store(0, std::memory_order_relaxed);
+			m_slots[i].data.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	bool Probe(uint64_t key, TTEntry& out) const
+	{
+		const Slot& s = m_slots[key & m_mask];
+		const uint64_t data = s.data.load(std::memory_order_relaxed);
+		const uint64_t check = s.check.load(std::memory_order_relaxed);
+		if ((check ^ data) != key || data == 0) return false;
+
+		out = Unpack(data);
+		return true;
+	}
+
+	void Store(uint64_t key, const TTEntry& e)
+	{
+		Slot& s = m_slots[key & m_mask];
+		const uint64_t oldData = s.data.load(std::memory_order_relaxed);
+		const uint64_t oldCheck = s.check.load(std::memory_order_relaxed);
+		if ((oldCheck ^ oldData) == key && Unpack(oldData).depth > e.depth)
+			return;
+
+		const uint64_t data = Pack(e);
+		s.check.store(key ^ data, std::memory_order_relaxed);
+		s.data.store(data, std::memory_order_relaxed);
+	}
+
+	size_t GetSlotCount() const { return m_mask + 1; }
+
+private:
+	struct Slot
+	{
+		std::atomic<uint64_t> check;
+		std::atomic<uint64_t> data;
+	};
+
+	// depth is stored +1 so an empty slot (data 0) never looks valid
+	static uint64_t Pack(const TTEntry& e)
+	{
+		return uint64_t(uint32_t(e.value)) |
+			(uint64_t(uint16_t(e.depth + 1)) << 32) |
+			(uint64_t(e.bound) << 48) |
+			(uint64_t(e.move) << 56);
+	}
+
+	static TTEntry Unpack(uint64_t data)
+	{
+		TTEntry e;
+		e.value = int32_t(uint32_t(data));
+		e.depth = int16_t(uint16_t(data >> 32) - 1);
+		e.bound = uint8_t(data >> 48);
+		e.move = uint8_t(data >> 56);
+		return e;
+	}
+
+private:
+	size_t m_mask;
+	std::unique_ptr<Slot[]> m_slots;
+};
@@ -0,0 +1,6 @@
+#pragma once
+
+/// Headless command-line tools (benchmarks, batch jobs).
+/// - Run as: CrowFramework <command> [--option value ...]
+/// - Returns the process exit code, or -1 when argv[1] is not a command
+int RunHeadlessCommand(int argc, char** argv);
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdlib>
+#include <cstring>
+
+/// Tiny "--name value" lookup for headless tools.
+class ToolArgs
+{
+public:
+	ToolArgs(int argc, char** argv) : m_argc(argc), m_argv(argv) {}
+
+	const char* Get(const char* name, const char* fallback) const
+	{
+		for (int i = 0; i + 1 < m_argc; ++i)
+			if (std::strcmp(m_argv[i], name) == 0)
+				return m_argv[i + 1];
+		return fallback;
+	}
+
+	long long GetInt(const char* name, long long fallback) const
+	{
+		const char* v = Get(name, nullptr);
+		return v ? std::strtoll(v, nullptr, 10) : fallback;
+	}
+
+	double GetDouble(const char* name, double fallback) const
+	{
+		const char* v = Get(name, nullptr);
+		return v ? std::strtod(v, nullptr) : fallback;
+	}
+
+	bool Has(const char* name) const
+	{
+		for (int i = 0; i < m_argc; ++i)
+			if (std::strcmp(m_argv[i], name) == 0)
+				return true;
+		return false;
+	}
+
+private:
+	int m_argc;
+	char** m_argv;
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include <game/SnakeRng.h>
+#include <game/SnakeTypes.h>
+
+#include <cstdlib>
+
+/// Food-seeking with random tie-breaks: long, varied games for the
+/// headless tools. Works on any game with GetHead, GetFood, GetDir and
+/// IsBlocked (SnakeGame, SparseSnakeGame, ...); draws one rng value per
+/// open neighbour, so a seed replays the same game on every engine.
+template <typename Game>
+Dir GreedyPolicy(const Game& game, SnakeRng& rng)
+{
+	const Cell head = game.GetHead();
+	const Cell food = game.GetFood();
+
+	Dir best = game.GetDir();
+	int bestCost = 1 << 30;
+	for (int i = 0; i < 4; ++i)
+	{
+		const Dir d = Dir(i);
+		const Cell c = Neighbor(head, d);
+		if (game.IsBlocked(c)) continue;
+
+		const int cost = (std::abs(c.x - food.x) + std::abs(c.y - food.y)) * 4 + int(rng.NextBelow(4));
+		if (cost < bestCost)
+		{
+			bestCost = cost;
+			best = d;
+		}
+	}
+	return best;
+}
@@ -0,0 +1,59 @@
+#include <api/SnakeEnvApi.h>
+#include <game/SnakeVecEnv.h>
+
+static_assert(SNAKE_ENV_PLANES == SnakeVecEnv::kPlanes, "C header and SnakeVecEnv disagree on planes");
+
+struct SnakeEnv
+{
+	SnakeVecEnv env;
+
+	SnakeEnv(int envs, int gridW, int gridH, int threads, int starveSteps)
+		: env(envs, gridW, gridH, threads, starveSteps)
+	{
+	}
+};
+
+int snake_env_abi_version(void)
+{
+	return SNAKE_ENV_ABI_VERSION;
+}
+
+SnakeEnv* snake_env_create(int envs, int grid_w, int grid_h, int threads, int starve_steps)
+{
+	if (envs < 1 || grid_w < 4 || grid_h < 2) return nullptr;
+
+	// Nothing may unwind across the C boundary
+	try
+	{
+		return new SnakeEnv(envs, grid_w, grid_h, threads, starve_steps);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+void snake_env_destroy(SnakeEnv* env)
+{
+	delete env;
+}
+
+size_t snake_env_obs_size(const SnakeEnv* env)
+{
+	return env->env.GetObsSize();
+}
+
+void snake_env_set_buffers(SnakeEnv* env, uint8_t* obs, float* rewards, uint8_t* dones, int32_t* final_scores)
+{
+	env->env.SetBuffers(obs, rewards, dones, final_scores);
+}
+
+void snake_env_reset(SnakeEnv* env, const uint64_t* seeds)
+{
+	env->env.Reset(seeds);
+}
+
+void snake_env_step(SnakeEnv* env, const uint8_t* actions)
+{
+	env->env.Step(actions);
+}
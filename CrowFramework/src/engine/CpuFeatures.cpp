@@ -0,0 +1,67 @@
+#include <engine/CpuFeatures.h>
+
+#if defined(CROW_ARCH_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(CROW_ARCH_X86)
+static void Cpuid(int leaf, int subleaf, unsigned regs[4])
+{
+#if defined(_MSC_VER)
+	int r[4];
+	__cpuidex(r, leaf, subleaf);
+	for (int i = 0; i < 4; i++) regs[i] = unsigned(r[i]);
+#else
+	__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static unsigned long long ReadXcr0()
+{
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#else
+	unsigned lo, hi;
+	__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+	return ((unsigned long long)hi << 32) | lo;
+#endif
+}
+#endif
+
+static CpuFeatures Detect()
+{
+	CpuFeatures f;
+
+#if defined(CROW_ARCH_X86)
+	unsigned regs[4];
+	Cpuid(0, 0, regs);
+	const unsigned maxLeaf = regs[0];
+
+	Cpuid(1, 0, regs);
+	f.popcnt = (regs[2] >> 23) & 1;
+
+	// AVX state must be enabled by the OS, not just supported by the CPU
+	const bool osxsave = (regs[2] >> 27) & 1;
+	const bool avx = (regs[2] >> 28) & 1;
+	const bool ymmEnabled = osxsave && (ReadXcr0() & 0x6) == 0x6;
+
+	if (maxLeaf >= 7)
+	{
+		Cpuid(7, 0, regs);
+		f.bmi2 = (regs[1] >> 8) & 1;
+		f.avx2 = avx && ymmEnabled && ((regs[1] >> 5) & 1);
+	}
+#endif
+
+	return f;
+}
+
+const CpuFeatures& GetCpuFeatures()
+{
+	static const CpuFeatures features = Detect();
+	return features;
+}
@@ -0,0 +1,87 @@
+#include <engine/InstanceRing.h>
+
+#include <cstddef>
+
+InstanceRing::~InstanceRing()
+{
+	Destroy();
+}
+
+void InstanceRing::Init(GLuint quadVbo, int capacity)
+{
+	Destroy();
+	m_capacity = capacity;
+
+	glGenVertexArrays(1, &m_vao);
+	glGenBuffers(1, &m_vbo);
+	glBindVertexArray(m_vao);
+
+	glBindBuffer(GL_ARRAY_BUFFER, quadVbo);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+	glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(capacity) * 2 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+	glVertexAttribDivisor(1, 1);
+	glEnableVertexAttribArray(1);
+
+	glBindVertexArray(0);
+	Clear();
+}
+
+void InstanceRing::Assign(const float* cells, int count)
+{
+	m_head = 0;
+	m_size = count;
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, GLsizeiptr(count) * 2 * sizeof(float), cells);
+}
+
+void InstanceRing::PushFront(float x, float y)
+{
+	const float cell[2] = { x, y };
+	m_head = (m_head + m_capacity - 1) % m_capacity;
+	++m_size;
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+	glBufferSubData(GL_ARRAY_BUFFER, GLintptr(m_head) * 2 * sizeof(float), sizeof(cell), cell);
+}
+
+void InstanceRing::PopBack()
+{
+	--m_size;
+}
+
+void InstanceRing::Clear()
+{
+	m_head = 0;
+	m_size = 0;
+}
+
+void InstanceRing::Draw()
+{
+	if (m_size == 0) return;
+
+	// Head run up to the end of the buffer, then the wrapped rest; the
+	// cell attribute is re-pointed at each run's first slot
+	const int first = m_head + m_size <= m_capacity ? m_size : m_capacity - m_head;
+	const int runs[2][2] = { { m_head, first }, { 0, m_size - first } };
+
+	glBindVertexArray(m_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+	for (const auto& run : runs)
+	{
+		if (run[1] == 0) continue;
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)(size_t(run[0]) * 2 * sizeof(float)));
+		glDrawArraysInstanced(GL_TRIANGLES, 0, 6, run[1]);
+	}
+	glBindVertexArray(0);
+}
+
+void InstanceRing::Destroy()
+{
+	if (m_vbo) glDeleteBuffers(1, &m_vbo);
+	if (m_vao) glDeleteVertexArrays(1, &m_vao);
+	m_vbo = 0;
+	m_vao = 0;
+}
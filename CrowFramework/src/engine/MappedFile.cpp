@@ -0,0 +1,115 @@
+#include <engine/MappedFile.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::Open(const char* path)
+{
+	Close();
+
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || uint64_t(size.QuadPart) > uint64_t(SIZE_MAX))
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	// A zero-length file cannot be mapped; it is simply empty
+	if (size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		m_open = true;
+		return true;
+	}
+
+	// The file handle can go now; the view keeps the file open
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping) return false;
+
+	const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view)
+	{
+		CloseHandle(mapping);
+		return false;
+	}
+
+	m_mapping = mapping;
+	m_data = static_cast<const uint8_t*>(view);
+	m_size = size_t(size.QuadPart);
+	m_open = true;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_data) UnmapViewOfFile(m_data);
+	if (m_mapping) CloseHandle(m_mapping);
+	m_data = nullptr;
+	m_mapping = nullptr;
+	m_size = 0;
+	m_open = false;
+}
+
+#else
+
+bool MappedFile::Open(const char* path)
+{
+	Close();
+
+	const int fd = open(path, O_RDONLY);
+	if (fd < 0) return false;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	if (st.st_size == 0)
+	{
+		close(fd);
+		m_open = true;
+		return true;
+	}
+
+	// The mapping stays valid after the descriptor closes
+	void* view = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (view == MAP_FAILED) return false;
+
+	m_data = static_cast<const uint8_t*>(view);
+	m_size = size_t(st.st_size);
+	m_open = true;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_data) munmap(const_cast<uint8_t*>(m_data), m_size);
+	m_data = nullptr;
+	m_size = 0;
+	m_open = false;
+}
+
+#endif
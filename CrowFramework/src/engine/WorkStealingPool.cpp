@@ -0,0 +1,137 @@
+#include <engine/WorkStealingPool.h>
+
+#include <cassert>
+
+// Which pool/worker the current thread belongs to
+static thread_local const WorkStealingPool* t_pool = nullptr;
+static thread_local int t_worker = -1;
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+	: m_queued(0), m_pending(0), m_nextQueue(0), m_stop(false)
+{
+	if (threadCount <= 0)
+		threadCount = HardwareThreads();
+
+	for (int i = 0; i < threadCount; ++i)
+		m_workers.push_back(std::make_unique<Worker>());
+
+	for (int i = 0; i < threadCount; ++i)
+		m_workers[i]->thread = std::thread(&WorkStealingPool::WorkerLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	Wait();
+
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+
+	for (auto& w : m_workers)
+		w->thread.join();
+}
+
+int WorkStealingPool::HardwareThreads()
+{
+	unsigned n = std::thread::hardware_concurrency();
+	return n ? int(n) : 1;
+}
+
+int WorkStealingPool::CurrentWorker() const
+{
+	return t_pool == this ? t_worker : -1;
+}
+
+void WorkStealingPool::Submit(Task task)
+{
+	m_pending.fetch_add(1, std::memory_order_relaxed);
+
+	// Local push from a worker, round-robin from outside
+	int target = CurrentWorker();
+	if (target < 0)
+		target = int(m_nextQueue.fetch_add(1, std::memory_order_relaxed) % uint32_t(m_workers.size()));
+
+	Push(target, std::move(task));
+}
+
+void WorkStealingPool::Push(int index, Task&& task)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_workers[index]->mutex);
+		m_workers[index]->tasks.push_back(std::move(task));
+	}
+	m_queued.fetch_add(1, std::memory_order_release);
+
+	// Take the sleep lock so a worker about to sleep cannot miss this
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+	}
+	m_wake.notify_one();
+}
+
+bool WorkStealingPool::PopLocal(int index, Task& out)
+{
+	Worker& w = *m_workers[index];
+	std::lock_guard<std::mutex> lock(w.mutex);
+	if (w.tasks.empty()) return false;
+
+	out = std::move(w.tasks.back());
+	w.tasks.pop_back();
+	m_queued.fetch_sub(1, std::memory_order_relaxed);
+	return true;
+}
+
+bool WorkStealingPool::Steal(int thief, Task& out)
+{
+	const int n = int(m_workers.size());
+	for (int k = 1; k < n; ++k)
+	{
+		Worker& victim = *m_workers[(thief + k) % n];
+		std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+		if (!lock.owns_lock() || victim.tasks.empty()) continue;
+
+		out = std::move(victim.tasks.front());
+		victim.tasks.pop_front();
+		m_queued.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+	return false;
+}
+
+void WorkStealingPool::WorkerLoop(int index)
+{
+	t_pool = this;
+	t_worker = index;
+
+	Task task;
+	while (true)
+	{
+		if (PopLocal(index, task) || Steal(index, task))
+		{
+			task(index);
+			task = nullptr;
+
+			if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				std::lock_guard<std::mutex> lock(m_sleepMutex);
+				m_idle.notify_all();
+			}
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_wake.wait(lock, [this] { return m_stop || m_queued.load(std::memory_order_acquire) > 0; });
+		if (m_stop && m_queued.load() == 0) return;
+	}
+}
+
+void WorkStealingPool::Wait()
+{
+	// The caller's own task keeps m_pending above zero
+	assert(CurrentWorker() < 0);
+
+	std::unique_lock<std::mutex> lock(m_sleepMutex);
+	m_idle.wait(lock, [this] { return m_pending.load(std::memory_order_acquire) == 0; });
+}
@@ -0,0 +1,223 @@
+#include <game/BitboardSnakeGame.h>
+#include <engine/BitOps.h>
+
+#include <algorithm>
+#include <cassert>
+
+using SelectBitFn = int (*)(uint64_t, int);
+
+static SelectBitFn PickSelectBit()
+{
+#if defined(CROW_ARCH_X64)
+	if (GetCpuFeatures().bmi2)
+		return &SelectBit64Bmi2;
+#endif
+	return &SelectBit64;
+}
+
+BitboardSnakeGame::BitboardSnakeGame(int gridW, int gridH, uint64_t seed)
+	: m_gridW(gridW), m_gridH(gridH),
+	m_rowMask(gridW >= 64 ? ~uint64_t(0) : (uint64_t(1) << gridW) - 1),
+	m_rows(size_t(gridH), 0),
+	m_freeCount(0),
+	m_dir(Dir::Right), m_pendingDir(Dir::Right),
+	m_gameOver(false), m_won(false),
+	m_stepTime(0.2f), m_acc(0.0f),
+	m_seed(seed)
+{
+	// Reset() puts the tail at gridW / 2 - 2
+	assert(gridW >= 4 && gridW <= kMaxGridW && gridH >= 1);
+
+	m_snake.Init(gridW * gridH);
+	Reset();
+}
+
+void BitboardSnakeGame::Reset()
+{
+	m_rng.Seed(m_seed);
+	m_snake.Clear();
+	std::fill(m_rows.begin(), m_rows.end(), uint64_t(0));
+	m_freeCount = m_gridW * m_gridH;
+	m_gameOver = false;
+	m_won = false;
+	m_acc = 0.0f;
+
+	m_dir = Dir::Right;
+	m_pendingDir = Dir::Right;
+
+	int cx = m_gridW / 2;
+	int cy = m_gridH / 2;
+
+	const Cell start[] = { { cx - 2, cy }, { cx - 1, cy }, { cx, cy } };
+	for (const Cell& part : start)
+	{
+		m_snake.PushFront(part);
+		Occupy(part);
+	}
+
+	SpawnFood();
+}
+
+void BitboardSnakeGame::Reset(uint64_t seed)
+{
+	m_seed = seed;
+	Reset();
+}
+
+void BitboardSnakeGame::Update(float dt)
+{
+	if (m_gameOver) return;
+
+	m_acc += dt;
+
+	while (m_acc >= m_stepTime)
+	{
+		Step();
+		m_acc -= m_stepTime;
+	}
+}
+
+void BitboardSnakeGame::SetPendingDir(Dir dir)
+{
+	if (!IsOpposite(m_dir, dir))
+		m_pendingDir = dir;
+}
+
+bool BitboardSnakeGame::IsGameOver() const
+{
+	return m_gameOver;
+}
+
+bool BitboardSnakeGame::IsWon() const
+{
+	return m_won;
+}
+
+const Cell& BitboardSnakeGame::GetHead() const
+{
+	return m_snake.Front();
+}
+
+BodySpans BitboardSnakeGame::GetBody() const
+{
+	return m_snake.Spans();
+}
+
+int BitboardSnakeGame::GetLength() const
+{
+	return m_snake.Size();
+}
+
+const Cell& BitboardSnakeGame::GetFood() const
+{
+	return m_food;
+}
+
+int BitboardSnakeGame::GetGridW() const
+{
+	return m_gridW;
+}
+
+int BitboardSnakeGame::GetGridH() const
+{
+	return m_gridH;
+}
+
+int BitboardSnakeGame::GetScore() const
+{
+	return m_snake.Size() - 3;
+}
+
+void BitboardSnakeGame::Step()
+{
+	m_dir = m_pendingDir;
+
+	Cell newHead = NextHead();
+
+	if (HitsWall(newHead) || HitsSelf(newHead))
+	{
+		m_gameOver = true;
+		return;
+	}
+
+	m_snake.PushFront(newHead);
+	Occupy(newHead);
+
+	if (EatsFood(newHead))
+		SpawnFood();
+	else
+	{
+		Release(m_snake.Back());
+		m_snake.PopBack();
+	}
+}
+
+Cell BitboardSnakeGame::NextHead() const
+{
+	return Neighbor(m_snake.Front(), m_dir);
+}
+
+bool BitboardSnakeGame::IsOpposite(Dir a, Dir b) const
+{
+	return (a == Dir::Up && b == Dir::Down) ||
+		(a == Dir::Down && b == Dir::Up) ||
+		(a == Dir::Left && b == Dir::Right) ||
+		(a == Dir::Right && b == Dir::Left);
+}
+
+bool BitboardSnakeGame::HitsWall(const Cell& c) const
+{
+	// Negative coordinates wrap to huge unsigned values: one compare per axis
+	return unsigned(c.x) >= unsigned(m_gridW) || unsigned(c.y) >= unsigned(m_gridH);
+}
+
+bool BitboardSnakeGame::HitsSelf(const Cell& c) const
+{
+	return (m_rows[c.y] >> c.x) & 1;
+}
+
+bool BitboardSnakeGame::EatsFood(const Cell& c) const
+{
+	return c.x == m_food.x && c.y == m_food.y;
+}
+
+void BitboardSnakeGame::SpawnFood()
+{
+	static const SelectBitFn selectBit = PickSelectBit();
+
+	if (m_freeCount == 0)
+	{
+		m_gameOver = true;
+		m_won = true;
+		m_food = { -1, -1 };
+		return;
+	}
+
+	int k = int(m_rng.NextBelow(uint32_t(m_freeCount)));
+
+	// Skip whole rows by their free count, then select inside the row
+	for (int y = 0; y < m_gridH; ++y)
+	{
+		uint64_t freeBits = ~m_rows[y] & m_rowMask;
+		int rowFree = PopCount64(freeBits);
+
+		if (k < rowFree)
+		{
+			m_food = { selectBit(freeBits, k), y };
+			return;
+		}
+		k -= rowFree;
+	}
+}
+
+void BitboardSnakeGame::Occupy(const Cell& c)
+{
+	m_rows[c.y] |= uint64_t(1) << c.x;
+	--m_freeCount;
+}
+
+void BitboardSnakeGame::Release(const Cell& c)
+{
+	m_rows[c.y] &= ~(uint64_t(1) << c.x);
+	++m_freeCount;
+}
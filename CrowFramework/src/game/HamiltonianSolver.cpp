@@ -0,0 +1,198 @@
+#include <game/HamiltonianSolver.h>
+#include <game/SnakeGame.h>
+
+namespace
+{
+	// A shortcut must leave length + kGrowthBuffer free cycle cells before
+	// the tail. Skipped cells only come back once the tail passes them, so
+	// this keeps a full body's worth of meals in hand while it does
+	const int kGrowthBuffer = 4;
+
+	Dir StepDir(const Cell& from, const Cell& to)
+	{
+		if (to.x > from.x) return Dir::Right;
+		if (to.x < from.x) return Dir::Left;
+		return to.y > from.y ? Dir::Down : Dir::Up;
+	}
+}
+
+HamiltonianSolver::HamiltonianSolver(int gridW, int gridH, float shortcutLimit)
+	: m_gridW(gridW), m_gridH(gridH), m_cells(gridW * gridH),
+	m_supported(gridW >= 2 && gridH >= 2 && (gridW % 2 == 0 || gridH % 2 == 0)),
+	m_shortcutMax(int(float(gridW * gridH) * shortcutLimit)),
+	m_order(nullptr), m_next(nullptr),
+	m_game(nullptr), m_expectedHead(-1), m_run(0), m_aligned(false)
+{
+	if (m_supported)
+		BuildCycle();
+}
+
+void HamiltonianSolver::BuildCycle()
+{
+	// Serpentine over the even dimension; the first column (or row) is
+	// left free as the way back to the start
+	std::vector<Cell> seq;
+	seq.reserve(size_t(m_cells));
+
+	if (m_gridH % 2 == 0)
+	{
+		for (int x = 0; x < m_gridW; ++x) seq.push_back({ x, 0 });
+		for (int y = 1; y < m_gridH; ++y)
+		{
+			if (y % 2)
+				for (int x = m_gridW - 1; x >= 1; --x) seq.push_back({ x, y });
+			else
+				for (int x = 1; x < m_gridW; ++x) seq.push_back({ x, y });
+		}
+		for (int y = m_gridH - 1; y >= 1; --y) seq.push_back({ 0, y });
+	}
+	else
+	{
+		for (int y = 0; y < m_gridH; ++y) seq.push_back({ 0, y });
+		for (int x = 1; x < m_gridW; ++x)
+		{
+			if (x % 2)
+				for (int y = m_gridH - 1; y >= 1; --y) seq.push_back({ x, y });
+			else
+				for (int y = 1; y < m_gridH; ++y) seq.push_back({ x, y });
+		}
+		for (int x = m_gridW - 1; x >= 1; --x) seq.push_back({ x, 0 });
+	}
+
+	for (int r = 0; r < 2; ++r)
+	{
+		m_orderTable[r].resize(size_t(m_cells));
+		m_nextTable[r].resize(size_t(m_cells));
+	}
+
+	const int n = m_cells;
+	for (int i = 0; i < n; ++i)
+	{
+		const Cell& c = seq[size_t(i)];
+		const size_t idx = size_t(c.y * m_gridW + c.x);
+
+		m_orderTable[0][idx] = i;
+		m_nextTable[0][idx] = uint8_t(StepDir(c, seq[size_t((i + 1) % n)]));
+
+		m_orderTable[1][idx] = (n - i) % n;
+		m_nextTable[1][idx] = uint8_t(StepDir(c, seq[size_t((i + n - 1) % n)]));
+	}
+
+	m_order = m_orderTable[0].data();
+	m_next = m_nextTable[0].data();
+}
+
+int HamiltonianSolver::Ahead(int from, int to) const
+{
+	const int d = m_order[to] - m_order[from];
+	return d < 0 ? d + m_cells : d;
+}
+
+void HamiltonianSolver::Prepare(const SnakeGame& game)
+{
+	m_game = &game;
+	const Cell head = game.GetHead();
+	m_expectedHead = head.y * m_gridW + head.x;
+	m_run = 0;
+	m_aligned = false;
+	if (!m_supported) return;
+
+	// Body read head first must step back one cycle cell per segment
+	const BodySpans body = game.GetBody();
+	for (int r = 0; r < 2 && !m_aligned; ++r)
+	{
+		const int* order = m_orderTable[r].data();
+		int expected = order[m_expectedHead];
+		bool contiguous = true;
+		body.ForEach([&](const Cell& c)
+			{
+				contiguous = contiguous && order[c.y * m_gridW + c.x] == expected;
+				expected = expected == 0 ? m_cells - 1 : expected - 1;
+			});
+
+		if (contiguous)
+		{
+			m_order = order;
+			m_next = m_nextTable[r].data();
+			m_aligned = true;
+		}
+	}
+
+	// Neither direction fits: bootstrap on the one whose next cell is open
+	if (!m_aligned)
+	{
+		m_order = m_orderTable[0].data();
+		m_next = m_nextTable[0].data();
+		if (game.IsBlocked(Neighbor(head, Dir(m_next[m_expectedHead]))))
+		{
+			m_order = m_orderTable[1].data();
+			m_next = m_nextTable[1].data();
+		}
+	}
+}
+
+Dir HamiltonianSolver::Decide(const SnakeGame& game)
+{
+	if (!m_supported) return game.GetDir();
+
+	const Cell head = game.GetHead();
+	const int h = head.y * m_gridW + head.x;
+	if (&game != m_game || h != m_expectedHead)
+		Prepare(game);
+
+	const int length = game.GetLength();
+	if (!m_aligned && m_run >= length - 1)
+		m_aligned = true;
+
+	const Dir succ = Dir(m_next[h]);
+	Dir choice = succ;
+
+	const Cell food = game.GetFood();
+	if (m_aligned && length < m_shortcutMax && food.x >= 0)
+	{
+		// Everything strictly between head and tail in cycle order is free
+		const Cell tail = game.GetTail();
+		const int room = Ahead(h, tail.y * m_gridW + tail.x);
+		const int toFood = Ahead(h, food.y * m_gridW + food.x);
+		const int margin = length + kGrowthBuffer;
+
+		int best = 1;
+		for (int i = 0; i < 4; ++i)
+		{
+			const Cell n = Neighbor(head, Dir(i));
+			if (n.x < 0 || n.y < 0 || n.x >= m_gridW || n.y >= m_gridH) continue;
+
+			const int a = Ahead(h, n.y * m_gridW + n.x);
+			if (a > best && a <= toFood && a < room - margin && !game.IsBlocked(n))
+			{
+				best = a;
+				choice = Dir(i);
+			}
+		}
+	}
+	else if (!m_aligned && ((int(succ) ^ int(game.GetDir())) == 1 || game.IsBlocked(Neighbor(head, succ))))
+	{
+		// Bootstrapping and the cycle is in the way: any open cell, restart the run
+		for (int i = 0; i < 4; ++i)
+		{
+			if ((i ^ int(game.GetDir())) == 1) continue;
+			if (!game.IsBlocked(Neighbor(head, Dir(i))))
+			{
+				choice = Dir(i);
+				break;
+			}
+		}
+		m_run = 0;
+	}
+
+	if (choice == succ) m_run++;
+
+	const Cell next = Neighbor(head, choice);
+	m_expectedHead = next.y * m_gridW + next.x;
+	return choice;
+}
+
+void HamiltonianSolver::Drive(SnakeGame& game)
+{
+	game.SetPendingDir(Decide(game));
+}
@@ -0,0 +1,221 @@
+#include <game/LevelMap.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+	const char kMagic[4] = { 'S', 'N', 'L', 'V' };
+	const uint32_t kVersion = 1;
+	const size_t kHeaderSize = 64;
+	const uint32_t kFieldCount = uint32_t(LevelField::kCount);
+
+	// SnakeReplay's 16-bit grid fields cap every grid at this size
+	const int kMaxSide = 65535;
+
+	void PutU32(uint8_t* p, uint32_t v)
+	{
+		for (int i = 0; i < 4; ++i) p[i] = uint8_t(v >> (8 * i));
+	}
+
+	void PutU64(uint8_t* p, uint64_t v)
+	{
+		for (int i = 0; i < 8; ++i) p[i] = uint8_t(v >> (8 * i));
+	}
+
+	uint32_t GetU32(const uint8_t* p)
+	{
+		uint32_t v = 0;
+		for (int i = 0; i < 4; ++i) v |= uint32_t(p[i]) << (8 * i);
+		return v;
+	}
+
+	uint64_t GetU64(const uint8_t* p)
+	{
+		uint64_t v = 0;
+		for (int i = 0; i < 8; ++i) v |= uint64_t(p[i]) << (8 * i);
+		return v;
+	}
+
+	uint64_t Fnv1a(const uint8_t* p, size_t n, uint64_t h = 0xCBF29CE484222325ull)
+	{
+		for (size_t i = 0; i < n; ++i)
+			h = (h ^ p[i]) * 0x100000001B3ull;
+		return h;
+	}
+
+	size_t Pad8(size_t n)
+	{
+		return (n + 7) & ~size_t(7);
+	}
+
+	// Multi-source BFS over open cells; dist[seed] = seedDist, walls stay
+	// kUnreachable, distances saturate one below it
+	void Bfs(int w, int h, const std::vector<uint8_t>& walls, const std::vector<int>& seeds, uint16_t seedDist,
+		std::vector<uint16_t>& dist)
+	{
+		dist.assign(walls.size(), LevelMap::kUnreachable);
+		std::vector<int> queue;
+		queue.reserve(walls.size());
+		for (int s : seeds)
+		{
+			dist[size_t(s)] = seedDist;
+			queue.push_back(s);
+		}
+
+		for (size_t head = 0; head < queue.size(); ++head)
+		{
+			const int c = queue[head];
+			const int x = c % w, y = c / w;
+			const uint16_t d = dist[size_t(c)] < LevelMap::kUnreachable - 1 ? uint16_t(dist[size_t(c)] + 1) : dist[size_t(c)];
+			const int next[4] = { y > 0 ? c - w : -1, y + 1 < h ? c + w : -1, x > 0 ? c - 1 : -1, x + 1 < w ? c + 1 : -1 };
+			for (int n : next)
+			{
+				if (n < 0 || walls[size_t(n)] || dist[size_t(n)] != LevelMap::kUnreachable) continue;
+				dist[size_t(n)] = d;
+				queue.push_back(n);
+			}
+		}
+	}
+}
+
+bool LevelMap::Build(const char* path, int gridW, int gridH, std::vector<uint8_t> walls)
+{
+	const size_t cells = size_t(gridW) * size_t(gridH);
+	if (gridW < 4 || gridH < 1 || gridW > kMaxSide || gridH > kMaxSide || walls.size() != cells)
+		return false;
+
+	// Same start as SnakeGame::Reset: body (cx-2..cx, cy) heading right
+	const int cx = gridW / 2, cy = gridH / 2;
+	for (int x = cx - 2; x <= cx + 1 && x < gridW; ++x)
+		walls[size_t(cy) * size_t(gridW) + size_t(x)] = 0;
+
+	const int spawn = cy * gridW + cx;
+	std::vector<uint16_t> fromSpawn, toWall;
+	Bfs(gridW, gridH, walls, { spawn }, 0, fromSpawn);
+
+	// Sealed pockets become walls
+	uint64_t open = 0;
+	for (size_t i = 0; i < cells; ++i)
+	{
+		if (fromSpawn[i] == kUnreachable) walls[i] = 1;
+		open += !walls[i];
+	}
+
+	// Clearance: open cells on the border are 1 step from the outside
+	std::vector<int> border;
+	for (int y = 0; y < gridH; ++y)
+		for (int x = 0; x < gridW; ++x)
+		{
+			const int c = y * gridW + x;
+			if (walls[size_t(c)]) continue;
+			const bool edge = x == 0 || y == 0 || x == gridW - 1 || y == gridH - 1;
+			const bool touches = (y > 0 && walls[size_t(c - gridW)]) || (y + 1 < gridH && walls[size_t(c + gridW)]) ||
+				(x > 0 && walls[size_t(c - 1)]) || (x + 1 < gridW && walls[size_t(c + 1)]);
+			if (edge || touches) border.push_back(c);
+		}
+	Bfs(gridW, gridH, walls, border, 1, toWall);
+
+	const size_t wallBytes = ((cells + 63) / 64) * 8;
+	const size_t fieldBytes = Pad8(cells * 2);
+	std::vector<uint8_t> file(kHeaderSize + wallBytes + fieldBytes * kFieldCount, 0);
+
+	uint8_t* bits = file.data() + kHeaderSize;
+	for (size_t i = 0; i < cells; ++i)
+		if (walls[i]) bits[i >> 3] |= uint8_t(1u << (i & 7));
+
+	const std::vector<uint16_t>* fields[kFieldCount] = { &fromSpawn, &toWall };
+	for (uint32_t f = 0; f < kFieldCount; ++f)
+	{
+		uint8_t* p = bits + wallBytes + fieldBytes * f;
+		for (size_t i = 0; i < cells; ++i)
+		{
+			p[i * 2] = uint8_t((*fields[f])[i]);
+			p[i * 2 + 1] = uint8_t((*fields[f])[i] >> 8);
+		}
+	}
+
+	uint8_t* header = file.data();
+	std::memcpy(header, kMagic, 4);
+	PutU32(header + 4, kVersion);
+	PutU32(header + 8, uint32_t(gridW));
+	PutU32(header + 12, uint32_t(gridH));
+	PutU64(header + 16, open);
+	PutU64(header + 24, kHeaderSize);
+	PutU64(header + 32, kHeaderSize + wallBytes);
+	PutU32(header + 40, kFieldCount);
+	PutU64(header + 48, Fnv1a(file.data() + kHeaderSize, file.size() - kHeaderSize));
+
+	FILE* out = std::fopen(path, "wb");
+	if (!out) return false;
+	const bool ok = std::fwrite(file.data(), 1, file.size(), out) == file.size();
+	return std::fclose(out) == 0 && ok;
+}
+
+bool LevelMap::Open(const char* path)
+{
+	Close();
+	if (!m_file.Open(path)) return false;
+
+	// The payload is read in place as uint64_t / uint16_t
+	const uint16_t probe = 1;
+	const bool littleEndian = *reinterpret_cast<const uint8_t*>(&probe) == 1;
+
+	const uint8_t* data = m_file.GetData();
+	const size_t size = m_file.GetSize();
+	if (!littleEndian || size < kHeaderSize || std::memcmp(data, kMagic, 4) != 0 || GetU32(data + 4) != kVersion ||
+		GetU32(data + 40) != kFieldCount)
+	{
+		Close();
+		return false;
+	}
+
+	const uint32_t w = GetU32(data + 8), h = GetU32(data + 12);
+	const size_t cells = size_t(w) * size_t(h);
+	const size_t wallBytes = ((cells + 63) / 64) * 8;
+	const uint64_t wallsOffset = GetU64(data + 24), fieldsOffset = GetU64(data + 32);
+	if (w < 4 || h < 1 || w > uint32_t(kMaxSide) || h > uint32_t(kMaxSide) || wallsOffset != kHeaderSize ||
+		fieldsOffset != kHeaderSize + wallBytes || size != fieldsOffset + Pad8(cells * 2) * kFieldCount)
+	{
+		Close();
+		return false;
+	}
+
+	// SnakeGame::Reset puts the body on (cx-2..cx, cy) and needs the cell
+	// ahead free; Build always clears them, a damaged file may not
+	const uint8_t* bits = data + wallsOffset;
+	const size_t cx = w / 2, cy = h / 2;
+	for (size_t x = cx - 2; x <= cx + 1 && x < w; ++x)
+	{
+		const size_t i = cy * w + x;
+		if ((bits[i >> 3] >> (i & 7)) & 1)
+		{
+			Close();
+			return false;
+		}
+	}
+
+	m_gridW = int(w);
+	m_gridH = int(h);
+	m_openCount = GetU64(data + 16);
+	m_walls = reinterpret_cast<const uint64_t*>(data + wallsOffset);
+	for (uint32_t f = 0; f < kFieldCount; ++f)
+		m_fields[f] = reinterpret_cast<const uint16_t*>(data + fieldsOffset + Pad8(cells * 2) * f);
+	return true;
+}
+
+void LevelMap::Close()
+{
+	m_file.Close();
+	m_gridW = m_gridH = 0;
+	m_openCount = 0;
+	m_walls = nullptr;
+	for (const uint16_t*& f : m_fields) f = nullptr;
+}
+
+bool LevelMap::Verify() const
+{
+	if (!m_walls) return false;
+	const uint8_t* data = m_file.GetData();
+	return GetU64(data + 48) == Fnv1a(data + kHeaderSize, m_file.GetSize() - kHeaderSize);
+}
@@ -0,0 +1,113 @@
+#include <game/PackedSnakeBody.h>
+
+#include <cstring>
+
+namespace
+{
+	// Byte of four steps -> offsets of the four cells behind the cell
+	// before them, walking tailwards from the highest step down
+	struct StepRun
+	{
+		int8_t dx[4], dy[4];
+	};
+
+	struct StepTable
+	{
+		StepRun runs[256];
+
+		StepTable()
+		{
+			const int dx[4] = { 0, 0, -1, 1 };
+			const int dy[4] = { -1, 1, 0, 0 };
+			for (int b = 0; b < 256; ++b)
+			{
+				int x = 0, y = 0;
+				for (int k = 0; k < 4; ++k)
+				{
+					const int d = (b >> ((3 - k) * 2)) & 3;
+					x -= dx[d];
+					y -= dy[d];
+					runs[b].dx[k] = int8_t(x);
+					runs[b].dy[k] = int8_t(y);
+				}
+			}
+		}
+	};
+
+	const StepTable kSteps;
+}
+
+void PackedSnakeBody::Init(int maxLength)
+{
+	unsigned cap = 32;
+	while (cap + 1 < unsigned(maxLength)) cap <<= 1;
+
+	if (size_t(cap / 32) > m_words.size())
+		m_words.resize(cap / 32);
+
+	m_mask = unsigned(m_words.size()) * 32 - 1;
+	Clear();
+}
+
+void PackedSnakeBody::Grow()
+{
+	// First step of a body that skipped Init: one word, nothing to move
+	if (m_words.empty())
+	{
+		m_words.resize(1);
+		m_mask = 31;
+		return;
+	}
+
+	// Same trick as SnakeBody::Grow: the wrapped part of the ring moves
+	// to the new upper half. Capacities are whole words, so whole words move
+	const unsigned cap = m_mask + 1;
+	m_words.resize(size_t(cap / 32) * 2);
+
+	const unsigned end = m_first + unsigned(m_steps);
+	if (end > cap)
+		std::memcpy(m_words.data() + cap / 32, m_words.data(), sizeof(uint64_t) * ((end - cap + 31) / 32));
+	m_mask = cap * 2 - 1;
+}
+
+void PackedSnakeBody::Assign(const Cell* cells, int count)
+{
+	Clear();
+	if (count > 0 && unsigned(count - 1) > m_mask + 1)
+		Init(count);
+	for (int i = count - 1; i >= 0; --i)
+		PushFront(cells[i]);
+}
+
+void PackedSnakeBody::Decode(Cell* dst) const
+{
+	if (m_size == 0) return;
+
+	Cell c = m_head;
+	*dst++ = c;
+
+	// Newest step first. Four steps at a time through the table once
+	// the position sits at the top of a byte
+	int i = m_steps - 1;
+	while (i >= 0)
+	{
+		const unsigned p = (m_first + unsigned(i)) & m_mask;
+		if ((p & 3) == 3 && i >= 3)
+		{
+			const unsigned byte = unsigned(m_words[p >> 5] >> ((p & 28) * 2)) & 0xFF;
+			const StepRun& run = kSteps.runs[byte];
+			for (int k = 0; k < 4; ++k)
+				dst[k] = { c.x + run.dx[k], c.y + run.dy[k] };
+			c = dst[3];
+			dst += 4;
+			i -= 4;
+			continue;
+		}
+
+		const unsigned d = unsigned(m_words[p >> 5] >> ((p & 31) * 2)) & 3;
+		c.x -= kDx[d];
+		c.y -= kDy[d];
+		*dst++ = c;
+		--i;
+	}
+}
@@ -0,0 +1,316 @@
+#include <game/SnakeArchive.h>
+#include <game/SnakeReplay.h>
+#include <game/SnakeTypes.h>
+
+#include <cstring>
+#include <filesystem>
+
+namespace
+{
+	const char kFileMagic[4] = { 'S', 'N', 'A', 'R' };
+	const char kRecordMagic[4] = { 'S', 'N', 'G', 'M' };
+	const char kFooterMagic[4] = { 'S', 'N', 'I', 'X' };
+	const uint32_t kVersion = 1;
+
+	const size_t kFileHeaderSize = 16;
+	const size_t kRecordHeaderSize = 32;
+	const size_t kFooterSize = 32;
+
+	// Step count cap while scanning for intact records (same as replays)
+	const uint64_t kMaxSteps = uint64_t(1) << 40;
+
+	void PutU16(uint8_t* p, uint32_t v)
+	{
+		p[0] = uint8_t(v);
+		p[1] = uint8_t(v >> 8);
+	}
+
+	void PutU32(uint8_t* p, uint32_t v)
+	{
+		for (int i = 0; i < 4; ++i) p[i] = uint8_t(v >> (8 * i));
+	}
+
+	void PutU64(uint8_t* p, uint64_t v)
+	{
+		for (int i = 0; i < 8; ++i) p[i] = uint8_t(v >> (8 * i));
+	}
+
+	uint32_t GetU16(const uint8_t* p)
+	{
+		return uint32_t(p[0]) | uint32_t(p[1]) << 8;
+	}
+
+	uint32_t GetU32(const uint8_t* p)
+	{
+		uint32_t v = 0;
+		for (int i = 0; i < 4; ++i) v |= uint32_t(p[i]) << (8 * i);
+		return v;
+	}
+
+	uint64_t GetU64(const uint8_t* p)
+	{
+		uint64_t v = 0;
+		for (int i = 0; i < 8; ++i) v |= uint64_t(p[i]) << (8 * i);
+		return v;
+	}
+
+	uint64_t Fnv1a(const uint8_t* p, size_t n, uint64_t h = 0xCBF29CE484222325ull)
+	{
+		for (size_t i = 0; i < n; ++i)
+			h = (h ^ p[i]) * 0x100000001B3ull;
+		return h;
+	}
+
+	// Record check: header without the check field, then the payload
+	uint32_t RecordHash(const uint8_t* record, size_t payloadBytes)
+	{
+		const uint64_t h = Fnv1a(record + kRecordHeaderSize, payloadBytes, Fnv1a(record, kRecordHeaderSize - 4));
+		return uint32_t(h ^ (h >> 32));
+	}
+
+	size_t PayloadBytes(uint64_t steps)
+	{
+		return size_t((steps + 3) / 4);
+	}
+
+	size_t RecordSize(uint64_t steps)
+	{
+		return kRecordHeaderSize + ((PayloadBytes(steps) + 7) & ~size_t(7));
+	}
+
+	// 64-bit offsets: archives of millions of games pass 2 GB
+	bool Seek(FILE* f, uint64_t offset)
+	{
+#if defined(_MSC_VER)
+		return _fseeki64(f, int64_t(offset), SEEK_SET) == 0;
+#else
+		return fseeko(f, off_t(offset), SEEK_SET) == 0;
+#endif
+	}
+}
+
+// ---- Writer ----------------------------------------------------------------
+
+SnakeArchiveWriter::~SnakeArchiveWriter()
+{
+	Close();
+}
+
+bool SnakeArchiveWriter::Open(const char* path)
+{
+	Close();
+	m_offsets.clear();
+
+	std::error_code ec;
+	if (!std::filesystem::exists(path, ec))
+	{
+		m_file = std::fopen(path, "w+b");
+		if (!m_file) return false;
+
+		uint8_t header[kFileHeaderSize] = {};
+		std::memcpy(header, kFileMagic, 4);
+		PutU32(header + 4, kVersion);
+		m_end = kFileHeaderSize;
+		m_committed = false;
+		return std::fwrite(header, 1, kFileHeaderSize, m_file) == kFileHeaderSize && Commit();
+	}
+
+	// Existing archive: take over its index; drop a torn tail so new
+	// records follow the last intact one
+	uint64_t fileSize = 0;
+	{
+		SnakeArchiveReader reader;
+		if (!reader.Open(path)) return false;
+		m_offsets.resize(size_t(reader.GetCount()));
+		for (uint64_t i = 0; i < reader.GetCount(); ++i)
+			m_offsets[size_t(i)] = reader.GetRecordOffset(i);
+		m_end = reader.GetDataEnd();
+		fileSize = reader.GetFileSize();
+		m_committed = !reader.WasRecovered();
+	}
+
+	if (!m_committed && fileSize != m_end)
+	{
+		std::filesystem::resize_file(path, m_end, ec);
+		if (ec) return false;
+	}
+
+	m_file = std::fopen(path, "r+b");
+	if (!m_file) return false;
+	if (Seek(m_file, m_end)) return true;
+	Close();
+	return false;
+}
+
+bool SnakeArchiveWriter::Append(const SnakeReplay& replay, int score)
+{
+	// Also keeps the grid inside the u16 fields
+	if (!m_file || !IsPlayableGrid(replay.GetGridW(), replay.GetGridH())) return false;
+
+	const uint64_t steps = replay.GetStepCount();
+	const size_t payload = PayloadBytes(steps);
+	const size_t size = RecordSize(steps);
+	m_buffer.assign(size, 0);
+
+	uint8_t* r = m_buffer.data();
+	std::memcpy(r, kRecordMagic, 4);
+	PutU16(r + 4, uint32_t(replay.GetGridW()));
+	PutU16(r + 6, uint32_t(replay.GetGridH()));
+	PutU64(r + 8, replay.GetSeed());
+	PutU64(r + 16, steps);
+	PutU32(r + 24, uint32_t(score));
+
+	const std::vector<uint64_t>& words = replay.GetWords();
+	for (size_t i = 0; i < payload; ++i)
+		r[kRecordHeaderSize + i] = uint8_t(words[i >> 3] >> ((i & 7) * 8));
+	PutU32(r + 28, RecordHash(r, payload));
+
+	// After a Commit the index and footer sit at m_end; overwrite them
+	if (m_committed && !Seek(m_file, m_end)) return false;
+	m_committed = false;
+
+	if (std::fwrite(r, 1, size, m_file) != size) return false;
+	m_offsets.push_back(m_end);
+	m_end += size;
+	return true;
+}
+
+bool SnakeArchiveWriter::Commit()
+{
+	if (!m_file) return false;
+	if (m_committed) return true;
+
+	// Records reach the OS before the footer that points at them
+	if (!Seek(m_file, m_end) || std::fflush(m_file) != 0) return false;
+
+	m_buffer.assign(m_offsets.size() * 8 + kFooterSize, 0);
+	uint8_t* index = m_buffer.data();
+	for (size_t i = 0; i < m_offsets.size(); ++i)
+		PutU64(index + i * 8, m_offsets[i]);
+
+	const size_t indexBytes = m_offsets.size() * 8;
+	uint8_t* footer = index + indexBytes;
+	std::memcpy(footer, kFooterMagic, 4);
+	PutU32(footer + 4, kVersion);
+	PutU64(footer + 8, uint64_t(m_offsets.size()));
+	PutU64(footer + 16, m_end);
+	PutU64(footer + 24, Fnv1a(footer + 8, 16, Fnv1a(index, indexBytes)));
+
+	if (std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) != m_buffer.size() || std::fflush(m_file) != 0)
+		return false;
+	m_committed = true;
+	return true;
+}
+
+bool SnakeArchiveWriter::Close()
+{
+	if (!m_file) return true;
+	const bool ok = Commit();
+	const bool closed = std::fclose(m_file) == 0;
+	m_file = nullptr;
+	return ok && closed;
+}
+
+// ---- Reader ----------------------------------------------------------------
+
+bool SnakeArchiveReader::Open(const char* path)
+{
+	Close();
+	if (!m_file.Open(path)) return false;
+
+	const uint8_t* data = m_file.GetData();
+	if (m_file.GetSize() < kFileHeaderSize || std::memcmp(data, kFileMagic, 4) != 0 || GetU32(data + 4) != kVersion)
+	{
+		Close();
+		return false;
+	}
+
+	if (!ReadFooter())
+		Recover();
+	return true;
+}
+
+void SnakeArchiveReader::Close()
+{
+	m_file.Close();
+	m_count = 0;
+	m_dataEnd = 0;
+	m_index = nullptr;
+	m_offsets.clear();
+	m_recovered = false;
+}
+
+bool SnakeArchiveReader::ReadFooter()
+{
+	const size_t size = m_file.GetSize();
+	if (size < kFileHeaderSize + kFooterSize) return false;
+
+	const uint8_t* data = m_file.GetData();
+	const uint8_t* footer = data + size - kFooterSize;
+	if (std::memcmp(footer, kFooterMagic, 4) != 0 || GetU32(footer + 4) != kVersion) return false;
+
+	// The index must end exactly where the footer starts
+	const uint64_t count = GetU64(footer + 8);
+	const uint64_t indexOffset = GetU64(footer + 16);
+	const uint64_t footerOffset = uint64_t(size - kFooterSize);
+	if (indexOffset < kFileHeaderSize || indexOffset > footerOffset ||
+		count != (footerOffset - indexOffset) / 8 || (footerOffset - indexOffset) % 8)
+		return false;
+
+	const uint8_t* index = data + indexOffset;
+	if (GetU64(footer + 24) != Fnv1a(footer + 8, 16, Fnv1a(index, size_t(count) * 8)))
+		return false;
+
+	m_index = index;
+	m_count = count;
+	m_dataEnd = indexOffset;
+	return true;
+}
+
+void SnakeArchiveReader::Recover()
+{
+	const uint8_t* data = m_file.GetData();
+	const uint64_t size = m_file.GetSize();
+	uint64_t pos = kFileHeaderSize;
+
+	while (size - pos >= kRecordHeaderSize)
+	{
+		const uint8_t* r = data + pos;
+		const uint64_t steps = GetU64(r + 16);
+		if (std::memcmp(r, kRecordMagic, 4) != 0 || steps >= kMaxSteps || RecordSize(steps) > size - pos ||
+			GetU32(r + 28) != RecordHash(r, PayloadBytes(steps)) || !IsPlayableGrid(GetU16(r + 4), GetU16(r + 6)))
+			break;
+
+		m_offsets.push_back(pos);
+		pos += RecordSize(steps);
+	}
+
+	m_count = uint64_t(m_offsets.size());
+	m_dataEnd = pos;
+	m_recovered = true;
+}
+
+uint64_t SnakeArchiveReader::GetRecordOffset(uint64_t i) const
+{
+	return m_index ? GetU64(m_index + size_t(i) * 8) : m_offsets[size_t(i)];
+}
+
+ArchivedGame SnakeArchiveReader::Get(uint64_t i) const
+{
+	const uint8_t* r = m_file.GetData() + GetRecordOffset(i);
+
+	ArchivedGame game;
+	game.gridW = int(GetU16(r + 4));
+	game.gridH = int(GetU16(r + 6));
+	game.seed = GetU64(r + 8);
+	game.steps = GetU64(r + 16);
+	game.score = int(GetU32(r + 24));
+	game.packed = r + kRecordHeaderSize;
+	return game;
+}
+
+bool SnakeArchiveReader::CheckRecord(uint64_t i) const
+{
+	const uint8_t* r = m_file.GetData() + GetRecordOffset(i);
+	return IsPlayableGrid(GetU16(r + 4), GetU16(r + 6)) && GetU32(r + 28) == RecordHash(r, PayloadBytes(GetU64(r + 16)));
+}
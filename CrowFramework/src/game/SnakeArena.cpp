@@ -0,0 +1,300 @@
+#include <game/SnakeArena.h>
+#include <engine/WorkStealingPool.h>
+
+#include <algorithm>
+
+namespace
+{
+	// Random draws before a placement gives up (snake) or scans (food)
+	const int kMaxDraws = 64;
+
+	// Snakes per work item in the parallel phases
+	const int64_t kGrain = 256;
+
+	bool IsOpposite(Dir a, Dir b)
+	{
+		return (a == Dir::Up && b == Dir::Down) ||
+			(a == Dir::Down && b == Dir::Up) ||
+			(a == Dir::Left && b == Dir::Right) ||
+			(a == Dir::Right && b == Dir::Left);
+	}
+}
+
+SnakeArena::SnakeArena(int gridW, int gridH, int snakeCount, int foodCount, uint64_t seed)
+	: m_gridW(gridW), m_gridH(gridH),
+	m_bands((gridH + kBandRows - 1) / kBandRows),
+	m_snakes(size_t(snakeCount)),
+	m_cells(size_t(gridW) * size_t(gridH), 0),
+	m_claims(m_cells.size(), 0),
+	m_food(size_t(foodCount)),
+	m_bandStart(size_t(m_bands) + 1, 0),
+	m_bandMoves(size_t(snakeCount)),
+	m_aliveCount(0), m_freeCount(0), m_tick(0),
+	m_seed(seed)
+{
+	for (Snake& s : m_snakes)
+		s.body.Init(4);
+	Reset();
+}
+
+void SnakeArena::Reset()
+{
+	std::fill(m_cells.begin(), m_cells.end(), 0u);
+	std::fill(m_claims.begin(), m_claims.end(), uint64_t(0));
+	m_rng.Seed(m_seed);
+	m_freeCount = int64_t(m_cells.size());
+	m_tick = 0;
+	m_aliveCount = 0;
+
+	for (int i = 0; i < GetSnakeCount(); ++i)
+		Spawn(i);
+	for (int i = 0; i < int(m_food.size()); ++i)
+		SpawnFood(i);
+}
+
+void SnakeArena::Reset(uint64_t seed)
+{
+	m_seed = seed;
+	Reset();
+}
+
+void SnakeArena::SetPendingDir(int snake, Dir d)
+{
+	Snake& s = m_snakes[size_t(snake)];
+	if (!IsOpposite(s.dir, d))
+		s.pendingDir = d;
+}
+
+int SnakeArena::GetOwner(const Cell& c) const
+{
+	if (HitsWall(c)) return -1;
+	const uint32_t w = m_cells[size_t(CellIndex(c))];
+	return (w && !(w & kFoodTag)) ? int(w) - 1 : -1;
+}
+
+bool SnakeArena::IsBlocked(const Cell& c) const
+{
+	if (HitsWall(c)) return true;
+	const uint32_t w = m_cells[size_t(CellIndex(c))];
+	return w && !(w & kFoodTag);
+}
+
+bool SnakeArena::HitsWall(const Cell& c) const
+{
+	return unsigned(c.x) >= unsigned(m_gridW) || unsigned(c.y) >= unsigned(m_gridH);
+}
+
+void SnakeArena::Spawn(int id)
+{
+	Snake& s = m_snakes[size_t(id)];
+	s.body.Clear();
+	s.alive = false;
+	s.ate = false;
+	s.cause = DeathCause::None;
+	s.score = 0;
+	s.target = -1;
+
+	// Three free cells in a line, head first in a random direction
+	for (int i = 0; i < kMaxDraws; ++i)
+	{
+		const Dir d = Dir(m_rng.NextBelow(4));
+		const Cell head = { int(m_rng.NextBelow(uint32_t(m_gridW))), int(m_rng.NextBelow(uint32_t(m_gridH))) };
+		const Dir back = d == Dir::Up ? Dir::Down : d == Dir::Down ? Dir::Up : d == Dir::Left ? Dir::Right : Dir::Left;
+
+		bool fits = true;
+		for (int k = 0; k < 3 && fits; ++k)
+		{
+			const Cell c = Neighbor(head, back, k);
+			fits = !HitsWall(c) && m_cells[size_t(CellIndex(c))] == 0;
+		}
+		if (!fits) continue;
+
+		// front = head, so push tail first
+		for (int k = 2; k >= 0; --k)
+		{
+			const Cell c = Neighbor(head, back, k);
+			s.body.PushFront(c);
+			m_cells[size_t(CellIndex(c))] = uint32_t(id) + 1;
+		}
+		s.dir = d;
+		s.pendingDir = d;
+		s.alive = true;
+		m_freeCount -= 3;
+		m_aliveCount++;
+		return;
+	}
+}
+
+void SnakeArena::SpawnFood(int slot)
+{
+	if (m_freeCount == 0)
+	{
+		m_food[size_t(slot)] = { -1, -1 };
+		return;
+	}
+
+	int index = -1;
+	for (int i = 0; i < kMaxDraws && index < 0; ++i)
+	{
+		const int c = int(m_rng.NextBelow(uint32_t(m_cells.size())));
+		if (m_cells[size_t(c)] == 0) index = c;
+	}
+
+	// Crowded board: k-th empty cell
+	if (index < 0)
+	{
+		int64_t k = int64_t(m_rng.Next() % uint64_t(m_freeCount));
+		for (size_t c = 0; c < m_cells.size(); ++c)
+			if (m_cells[c] == 0 && k-- == 0)
+			{
+				index = int(c);
+				break;
+			}
+	}
+
+	m_cells[size_t(index)] = kFoodTag | uint32_t(slot);
+	m_food[size_t(slot)] = { index % m_gridW, index / m_gridW };
+	m_freeCount--;
+}
+
+// Phase 1, per snake: next head against walls and start-of-tick bodies
+void SnakeArena::Move(int begin, int end)
+{
+	for (int id = begin; id < end; ++id)
+	{
+		Snake& s = m_snakes[size_t(id)];
+		if (!s.alive) continue;
+
+		s.dir = s.pendingDir;
+		s.ate = false;
+		const Cell head = Neighbor(s.body.Front(), s.dir);
+		if (HitsWall(head))
+		{
+			s.cause = DeathCause::Wall;
+			s.target = -1;
+			continue;
+		}
+
+		s.target = CellIndex(head);
+		const uint32_t w = m_cells[size_t(s.target)];
+		if (w && !(w & kFoodTag))
+			s.cause = w == uint32_t(id) + 1 ? DeathCause::Self : DeathCause::Snake;
+	}
+}
+
+// Phase 2, per band: the first claim on a cell stands until a second one
+// arrives, then both die. Every claimant of a cell is in the same band,
+// so bands never touch each other's snakes
+void SnakeArena::ResolveBand(int band)
+{
+	const uint64_t stamp = m_tick << 32;
+	for (int i = m_bandStart[size_t(band)]; i < m_bandStart[size_t(band) + 1]; ++i)
+	{
+		const int id = m_bandMoves[size_t(i)];
+		uint64_t& claim = m_claims[size_t(m_snakes[size_t(id)].target)];
+		if ((claim & ~uint64_t(0xFFFFFFFF)) == stamp)
+		{
+			m_snakes[size_t(claim & 0xFFFFFFFF)].cause = DeathCause::HeadOn;
+			m_snakes[size_t(id)].cause = DeathCause::HeadOn;
+		}
+		else
+			claim = stamp | uint64_t(id);
+	}
+}
+
+// Phase 3, per snake: survivors move, the dead leave the board. Every
+// write hits a cell only this snake touches: its own body, or a target
+// that was empty and is claimed by nobody else
+void SnakeArena::Apply(int begin, int end)
+{
+	for (int id = begin; id < end; ++id)
+	{
+		Snake& s = m_snakes[size_t(id)];
+		if (!s.alive) continue;
+
+		if (s.cause != DeathCause::None)
+		{
+			s.body.Spans().ForEach([&](const Cell& c) { m_cells[size_t(CellIndex(c))] = 0; });
+			s.alive = false;
+			continue;
+		}
+
+		uint32_t& w = m_cells[size_t(s.target)];
+		s.ate = (w & kFoodTag) != 0;
+		if (s.ate)
+		{
+			s.target = int(w & ~kFoodTag); // food slot to refill
+			s.score++;
+		}
+		w = uint32_t(id) + 1;
+
+		if (s.body.Size() == s.body.Capacity())
+			s.body.Grow();
+		s.body.PushFront(Neighbor(s.body.Front(), s.dir));
+
+		if (!s.ate)
+		{
+			m_cells[size_t(CellIndex(s.body.Back()))] = 0;
+			s.body.PopBack();
+		}
+	}
+}
+
+void SnakeArena::Tick(WorkStealingPool* pool)
+{
+	if (m_aliveCount == 0) return;
+	++m_tick;
+
+	const int n = GetSnakeCount();
+	if (pool)
+		pool->ParallelFor(0, n, kGrain, [this](int64_t b, int64_t e, int) { Move(int(b), int(e)); });
+	else
+		Move(0, n);
+
+	// Bucket the surviving moves by target band, in snake id order
+	std::fill(m_bandStart.begin(), m_bandStart.end(), 0);
+	for (const Snake& s : m_snakes)
+		if (s.alive && s.cause == DeathCause::None)
+			m_bandStart[size_t(s.target / m_gridW / kBandRows) + 1]++;
+	for (int b = 0; b < m_bands; ++b)
+		m_bandStart[size_t(b) + 1] += m_bandStart[size_t(b)];
+	for (int id = 0; id < n; ++id)
+	{
+		const Snake& s = m_snakes[size_t(id)];
+		if (s.alive && s.cause == DeathCause::None)
+			m_bandMoves[size_t(m_bandStart[size_t(s.target / m_gridW / kBandRows)]++)] = id;
+	}
+	for (int b = m_bands; b > 0; --b)
+		m_bandStart[size_t(b)] = m_bandStart[size_t(b) - 1];
+	m_bandStart[0] = 0;
+
+	if (pool)
+	{
+		pool->ParallelFor(0, m_bands, 1, [this](int64_t b, int64_t e, int)
+			{
+				for (int64_t band = b; band < e; ++band) ResolveBand(int(band));
+			});
+		pool->ParallelFor(0, n, kGrain, [this](int64_t b, int64_t e, int) { Apply(int(b), int(e)); });
+	}
+	else
+	{
+		for (int band = 0; band < m_bands; ++band) ResolveBand(band);
+		Apply(0, n);
+	}
+
+	// Serial tail: bookkeeping and food, in snake id order
+	for (Snake& s : m_snakes)
+	{
+		if (!s.alive && s.cause != DeathCause::None && s.body.Size() > 0)
+		{
+			m_freeCount += s.body.Size();
+			m_aliveCount--;
+			s.body.Clear();
+		}
+		else if (s.ate)
+		{
+			s.ate = false;
+			SpawnFood(s.target);
+		}
+	}
+}
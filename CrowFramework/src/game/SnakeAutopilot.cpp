@@ -0,0 +1,273 @@
+#include <game/SnakeAutopilot.h>
+#include <game/SnakeGame.h>
+#include <game/LevelMap.h>
+
+#include <algorithm>
+#include <climits>
+#include <utility>
+
+namespace
+{
+	// Stamps replace clearing the grids; on wrap-around clear once
+	uint32_t NextStamp(uint32_t& stamp, std::vector<uint32_t>& marks)
+	{
+		if (++stamp == 0)
+		{
+			std::fill(marks.begin(), marks.end(), 0u);
+			stamp = 1;
+		}
+		return stamp;
+	}
+}
+
+// Grids carry a one-cell wall border so neighbors need no bounds checks:
+// cell (x, y) lives at (y + 1) * stride + (x + 1)
+SnakeAutopilot::SnakeAutopilot(int gridW, int gridH)
+	: m_gridW(gridW), m_gridH(gridH), m_cells(gridW * gridH),
+	m_stride(gridW + 2),
+	m_body(size_t(gridW) * size_t(gridH) + 1),
+	m_pathBuf(size_t(gridW) * size_t(gridH) + 1),
+	m_bodyMark(size_t(gridW + 2) * size_t(gridH + 2), 0),
+	m_freeAt(size_t(gridW + 2) * size_t(gridH + 2), 0),
+	m_seenMark(size_t(gridW + 2) * size_t(gridH + 2), 0),
+	m_dist(size_t(gridW + 2) * size_t(gridH + 2), 0),
+	m_parent(size_t(gridW + 2) * size_t(gridH + 2), 0),
+	m_wall(size_t(gridW + 2) * size_t(gridH + 2), 1),
+	m_planDirs(size_t(gridW) * size_t(gridH)),
+	m_planPos(0), m_planSize(0), m_planHead(-1), m_planFood{ -1, -1 }, m_planLength(0),
+	m_planGame(nullptr),
+	m_bodyStamp(0), m_seenStamp(0)
+{
+	for (int y = 0; y < gridH; ++y)
+		for (int x = 0; x < gridW; ++x)
+			m_wall[size_t(Pad(x, y))] = 0;
+
+	unsigned cap = 1;
+	while (cap < unsigned(m_cells)) cap <<= 1;
+	m_queue.resize(cap);
+	m_queueMask = cap - 1;
+
+	m_offset[int(Dir::Up)] = -m_stride;
+	m_offset[int(Dir::Down)] = m_stride;
+	m_offset[int(Dir::Left)] = -1;
+	m_offset[int(Dir::Right)] = 1;
+}
+
+Dir SnakeAutopilot::Decide(const SnakeGame& game)
+{
+	if (game.GetLevel() != m_level)
+		LoadWalls(game);
+
+	Dir planned;
+	if (FollowPlan(game, planned))
+		return planned;
+	m_planSize = 0;
+
+	LoadBody(game);
+	const int length = game.GetLength();
+	const int head = m_body[0];
+	const Dir current = game.GetDir();
+
+	StampBody(length);
+
+	// 1) Shortest path to the food, if the snake survives eating it
+	const Cell food = game.GetFood();
+	if (food.x >= 0)
+	{
+		const int foodCell = Pad(food.x, food.y);
+		if (Search(head, foodCell) > 0)
+		{
+			const int steps = TracePath(head, foodCell);
+
+			// Keep the directions before the safety check reuses the BFS grids
+			for (int i = 0; i < steps; ++i)
+				m_planDirs[size_t(i)] = m_parent[size_t(m_pathBuf[size_t(steps - 1 - i)])];
+
+			if (SafeAfterEating(steps, length))
+			{
+				const Dir first = Dir(m_planDirs[0]);
+				m_planGame = &game;
+				m_planFood = food;
+				m_planLength = length;
+				m_planSize = steps;
+				m_planPos = 1;
+				m_planHead = head + m_offset[int(first)];
+				return first;
+			}
+		}
+	}
+
+	// 2) Stall: the tail-safe move with the longest way back to the tail
+	Dir best = current;
+	int bestScore = -1;
+	for (int i = 0; i < 4; ++i)
+	{
+		const Dir d = Dir(i);
+		if ((i ^ int(current)) == 1) continue;
+
+		const int next = head + m_offset[i];
+		if (!Enterable(next, 1)) continue;
+
+		const int toTail = TailDistanceAfter(next, length, food.x >= 0 && next == Pad(food.x, food.y));
+		if (toTail > bestScore)
+		{
+			bestScore = toTail;
+			best = d;
+		}
+	}
+	if (bestScore >= 0) return best;
+
+	// 3) Trapped either way: the move into the biggest open area
+	StampBody(length);
+	int bestArea = -1;
+	for (int i = 0; i < 4; ++i)
+	{
+		if ((i ^ int(current)) == 1) continue;
+
+		const int next = head + m_offset[i];
+		if (!Enterable(next, 1)) continue;
+
+		const int area = Search(next, -1);
+		if (area > bestArea)
+		{
+			bestArea = area;
+			best = Dir(i);
+		}
+	}
+	return best;
+}
+
+void SnakeAutopilot::Drive(SnakeGame& game)
+{
+	game.SetPendingDir(Decide(game));
+}
+
+bool SnakeAutopilot::FollowPlan(const SnakeGame& game, Dir& out)
+{
+	if (m_planPos >= m_planSize || m_planGame != &game || game.GetLength() != m_planLength)
+		return false;
+
+	const Cell head = game.GetHead();
+	const Cell food = game.GetFood();
+	if (food.x != m_planFood.x || food.y != m_planFood.y || Pad(head.x, head.y) != m_planHead)
+		return false;
+
+	// The plan was proven safe for the body it saw; re-check the next cell
+	// in case the game was driven off-plan and back onto the same head
+	const Dir d = Dir(m_planDirs[size_t(m_planPos)]);
+	if (game.IsBlocked(Neighbor(head, d))) return false;
+
+	m_planPos++;
+	m_planHead += m_offset[int(d)];
+	out = d;
+	return true;
+}
+
+void SnakeAutopilot::LoadWalls(const SnakeGame& game)
+{
+	m_level = game.GetLevel();
+	m_planSize = 0;
+	for (int y = 0; y < m_gridH; ++y)
+		for (int x = 0; x < m_gridW; ++x)
+			m_wall[size_t(Pad(x, y))] = m_level && m_level->IsWall({ x, y }) ? 1 : 0;
+}
+
+void SnakeAutopilot::LoadBody(const SnakeGame& game)
+{
+	int* out = m_body.data();
+	game.GetBody().ForEach([&](const Cell& c) { *out++ = Pad(c.x, c.y); });
+}
+
+void SnakeAutopilot::StampBody(int length)
+{
+	const uint32_t stamp = NextStamp(m_bodyStamp, m_bodyMark);
+	for (int k = 0; k < length; ++k)
+	{
+		const int c = m_body[size_t(k)];
+		m_bodyMark[size_t(c)] = stamp;
+		m_freeAt[size_t(c)] = length - k + 1;
+	}
+}
+
+bool SnakeAutopilot::Enterable(int cell, int step) const
+{
+	if (m_wall[size_t(cell)]) return false;
+	return m_bodyMark[size_t(cell)] != m_bodyStamp || m_freeAt[size_t(cell)] <= step;
+}
+
+int SnakeAutopilot::Search(int start, int target)
+{
+	const uint32_t stamp = NextStamp(m_seenStamp, m_seenMark);
+	unsigned qHead = 0, qTail = 0;
+
+	m_seenMark[size_t(start)] = stamp;
+	m_dist[size_t(start)] = 0;
+	m_queue[qTail++ & m_queueMask] = start;
+	int visited = 0;
+
+	while (qHead != qTail)
+	{
+		const int c = m_queue[qHead++ & m_queueMask];
+		const int t = m_dist[size_t(c)];
+		if (c == target) return t;
+		visited++;
+
+		for (int i = 0; i < 4; ++i)
+		{
+			const int n = c + m_offset[i];
+			if (m_seenMark[size_t(n)] == stamp || !Enterable(n, t + 1)) continue;
+
+			m_seenMark[size_t(n)] = stamp;
+			m_dist[size_t(n)] = t + 1;
+			m_parent[size_t(n)] = uint8_t(i);
+			m_queue[qTail++ & m_queueMask] = n;
+		}
+	}
+	return target < 0 ? visited : -1;
+}
+
+int SnakeAutopilot::TracePath(int start, int end)
+{
+	// m_pathBuf = end, ..., first step (head excluded)
+	int steps = 0;
+	for (int c = end; c != start; c -= m_offset[m_parent[size_t(c)]])
+		m_pathBuf[size_t(steps++)] = c;
+	return steps;
+}
+
+bool SnakeAutopilot::SafeAfterEating(int steps, int length)
+{
+	// Board full after this meal = win, nothing left to reach
+	const int newLength = length + 1;
+	if (newLength >= m_cells) return true;
+
+	// Virtual snake: the path (newest first), then as much of the old body as fits
+	for (int i = 0; steps + i < newLength; ++i)
+		m_pathBuf[size_t(steps + i)] = m_body[size_t(i)];
+
+	std::swap(m_body, m_pathBuf);
+	StampBody(newLength);
+	const bool safe = Search(m_body[0], m_body[size_t(newLength - 1)]) >= 0;
+	std::swap(m_body, m_pathBuf);
+
+	StampBody(length);
+	return safe;
+}
+
+int SnakeAutopilot::TailDistanceAfter(int next, int length, bool eats)
+{
+	const int newLength = eats ? length + 1 : length;
+	if (newLength >= m_cells) return INT_MAX / 2;
+
+	m_pathBuf[0] = next;
+	for (int i = 1; i < newLength; ++i)
+		m_pathBuf[size_t(i)] = m_body[size_t(i - 1)];
+
+	std::swap(m_body, m_pathBuf);
+	StampBody(newLength);
+	const int dist = Search(next, m_body[size_t(newLength - 1)]);
+	std::swap(m_body, m_pathBuf);
+
+	StampBody(length);
+	return dist;
+}
@@ -0,0 +1,301 @@
+#include <game/SnakeBatch.h>
+#include <game/SnakeBatchKernels.h>
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+
+static_assert(sizeof(Dir) == sizeof(int32_t), "kernels read Dir arrays as int32");
+
+SnakeBatch::SnakeBatch(int count, int gridW, int gridH)
+	: m_count(count), m_gridW(gridW), m_gridH(gridH),
+	m_cells(gridW * gridH)
+{
+	assert(count > 0 && gridW >= 4 && gridH >= 1);
+
+	m_bodyCap = 1;
+	while (m_bodyCap < m_cells) m_bodyCap <<= 1;
+	m_bodyStride = m_bodyCap + 64 / int(sizeof(Cell));
+	m_occStride = (m_cells + 63) & ~63;
+
+	const size_t n = size_t(count);
+	m_headX.resize(n);
+	m_headY.resize(n);
+	m_dir.resize(n);
+	m_pendingDir.resize(n);
+	m_foodCell.resize(n);
+	m_length.resize(n);
+	m_bodyHead.resize(n);
+	m_freeCount.resize(n);
+	m_rng.resize(n);
+	m_state.resize(n);
+	m_nextX.resize(n);
+	m_nextY.resize(n);
+	m_outcome.resize(n);
+
+	// AVX2 gathers read 4 bytes at a byte offset: pad the tail
+	m_body.resize(n * size_t(m_bodyStride));
+	m_occupied.resize(n * size_t(m_occStride) + 4);
+	m_freeCells.resize(n * size_t(m_cells));
+	m_freePos.resize(n * size_t(m_cells));
+
+	for (int i = 0; i < count; ++i)
+		Reset(i, SnakeRng::kDefaultSeed);
+
+	SetKernel(SnakeBatchKernel::Auto);
+}
+
+void SnakeBatch::SetKernel(SnakeBatchKernel kernel)
+{
+	// Gather offsets are int32
+	const bool avx2Usable = GetCpuFeatures().avx2 &&
+		int64_t(m_count) * int64_t(m_occStride) < int64_t(INT_MAX);
+
+	m_kernel = SnakeBatchKernel::Scalar;
+	m_plan = &PlanStepScalar;
+
+#if defined(CROW_ARCH_X86)
+	if (kernel != SnakeBatchKernel::Scalar && avx2Usable)
+	{
+		m_kernel = SnakeBatchKernel::Avx2;
+		m_plan = &PlanStepAvx2;
+	}
+#else
+	(void)kernel;
+	(void)avx2Usable;
+#endif
+}
+
+void SnakeBatch::Reset(int game, uint64_t seed)
+{
+	const GameBlocks b = Blocks(game);
+	std::fill_n(b.occupied, m_occStride, uint8_t(0));
+	for (int c = 0; c < m_cells; ++c)
+	{
+		b.freeCells[c] = c;
+		b.freePos[c] = c;
+	}
+	m_freeCount[game] = m_cells;
+
+	m_length[game] = 0;
+	m_bodyHead[game] = 0;
+	m_state[game] = Alive;
+	m_dir[game] = int32_t(Dir::Right);
+	m_pendingDir[game] = int32_t(Dir::Right);
+	m_rng[game].Seed(seed);
+
+	int cx = m_gridW / 2;
+	int cy = m_gridH / 2;
+
+	// Same order as SnakeGame::Reset so the free list matches
+	PushFront(game, b, cx - 2, cy);
+	PushFront(game, b, cx - 1, cy);
+	PushFront(game, b, cx, cy);
+
+	SpawnFood(game, b);
+}
+
+void SnakeBatch::ResetAll(const uint64_t* seeds)
+{
+	for (int i = 0; i < m_count; ++i)
+		Reset(i, seeds[i]);
+}
+
+void SnakeBatch::Step(const Dir* actions, uint8_t* done, float* rewards)
+{
+	SnakeBatchKernelArgs args;
+	args.count = m_count;
+	args.gridW = m_gridW;
+	args.gridH = m_gridH;
+	args.occStride = m_occStride;
+	args.actions = reinterpret_cast<const int32_t*>(actions);
+	args.state = m_state.data();
+	args.dir = m_dir.data();
+	args.pendingDir = m_pendingDir.data();
+	args.headX = m_headX.data();
+	args.headY = m_headY.data();
+	args.foodCell = m_foodCell.data();
+	args.occupied = m_occupied.data();
+	args.nextX = m_nextX.data();
+	args.nextY = m_nextY.data();
+	args.outcome = m_outcome.data();
+
+	m_plan(args, 0, m_count);
+	CommitAll(done, rewards);
+}
+
+void SnakeBatch::CommitAll(uint8_t* done, float* rewards)
+{
+	// Hot loop: array bases in locals, since the byte stores below would
+	// otherwise force the compiler to reload every vector pointer
+	const int32_t* outcome = m_outcome.data();
+	const int32_t* nextX = m_nextX.data();
+	const int32_t* nextY = m_nextY.data();
+	int32_t* headX = m_headX.data();
+	int32_t* headY = m_headY.data();
+	uint32_t* bodyHead = m_bodyHead.data();
+	int32_t* length = m_length.data();
+	int32_t* freeCount = m_freeCount.data();
+	uint8_t* state = m_state.data();
+	const unsigned mask = unsigned(m_bodyCap - 1);
+	const int gridW = m_gridW;
+
+	for (int i = 0; i < m_count; ++i)
+	{
+		float reward = 0.0f;
+		const int32_t result = outcome[i];
+
+		if (result == StepDie)
+		{
+			state[i] = Dead;
+			reward = -1.0f;
+		}
+		else if (result != StepSkip)
+		{
+			const GameBlocks b = Blocks(i);
+			const int x = nextX[i];
+			const int y = nextY[i];
+
+			// PushFront + Occupy
+			const unsigned head = (bodyHead[i] - 1) & mask;
+			b.body[head] = { x, y };
+			bodyHead[i] = head;
+			headX[i] = x;
+			headY[i] = y;
+
+			const int cell = y * gridW + x;
+			int count = freeCount[i];
+			b.occupied[cell] = 1;
+
+			const int slot = b.freePos[cell];
+			const int last = b.freeCells[--count];
+			b.freeCells[slot] = last;
+			b.freePos[last] = slot;
+			b.freePos[cell] = -1;
+
+			if (result == StepEat)
+			{
+				length[i]++;
+				freeCount[i] = count;
+				SpawnFood(i, b);
+				reward = 1.0f;
+			}
+			else
+			{
+				// PopBack + release the old tail (length unchanged overall)
+				const Cell tail = b.body[(head + unsigned(length[i])) & mask];
+				const int tailCell = tail.y * gridW + tail.x;
+				b.occupied[tailCell] = 0;
+				b.freeCells[count] = tailCell;
+				b.freePos[tailCell] = count++;
+				freeCount[i] = count;
+			}
+		}
+
+		if (done) done[i] = state[i] != Alive;
+		if (rewards) rewards[i] = reward;
+	}
+}
+
+SnakeBatch::GameBlocks SnakeBatch::Blocks(int game)
+{
+	GameBlocks b;
+	b.body = m_body.data() + size_t(game) * size_t(m_bodyStride);
+	b.occupied = m_occupied.data() + size_t(game) * size_t(m_occStride);
+	b.freeCells = m_freeCells.data() + size_t(game) * size_t(m_cells);
+	b.freePos = m_freePos.data() + size_t(game) * size_t(m_cells);
+	return b;
+}
+
+void SnakeBatch::PushFront(int game, const GameBlocks& b, int x, int y)
+{
+	const unsigned mask = unsigned(m_bodyCap - 1);
+	const unsigned head = (m_bodyHead[game] - 1) & mask;
+
+	b.body[head] = { x, y };
+	m_bodyHead[game] = head;
+	m_length[game]++;
+	m_headX[game] = x;
+	m_headY[game] = y;
+
+	Occupy(game, b, y * m_gridW + x);
+}
+
+void SnakeBatch::Occupy(int game, const GameBlocks& b, int cell)
+{
+	b.occupied[cell] = 1;
+
+	int slot = b.freePos[cell];
+	int last = b.freeCells[--m_freeCount[game]];
+	b.freeCells[slot] = last;
+	b.freePos[last] = slot;
+	b.freePos[cell] = -1;
+}
+
+void SnakeBatch::SpawnFood(int game, const GameBlocks& b)
+{
+	if (m_freeCount[game] == 0)
+	{
+		m_state[game] = Won;
+		m_foodCell[game] = -1;
+		return;
+	}
+
+	int slot = int(m_rng[game].NextBelow(uint32_t(m_freeCount[game])));
+	m_foodCell[game] = b.freeCells[slot];
+}
+
+bool SnakeBatch::IsGameOver(int game) const
+{
+	return m_state[game] != Alive;
+}
+
+bool SnakeBatch::IsWon(int game) const
+{
+	return m_state[game] == Won;
+}
+
+int SnakeBatch::GetLength(int game) const
+{
+	return m_length[game];
+}
+
+int SnakeBatch::GetScore(int game) const
+{
+	return m_length[game] - 3;
+}
+
+Cell SnakeBatch::GetHead(int game) const
+{
+	return { m_headX[game], m_headY[game] };
+}
+
+Cell SnakeBatch::GetFood(int game) const
+{
+	const int cell = m_foodCell[game];
+	if (cell < 0) return { -1, -1 };
+	return { cell % m_gridW, cell / m_gridW };
+}
+
+Dir SnakeBatch::GetDir(int game) const
+{
+	return Dir(m_dir[game]);
+}
+
+BodySpans SnakeBatch::GetBody(int game) const
+{
+	const Cell* ring = m_body.data() + size_t(game) * size_t(m_bodyStride);
+	const int head = int(m_bodyHead[game]);
+	const int length = m_length[game];
+	const int firstSize = (head + length <= m_bodyCap) ? length : m_bodyCap - head;
+
+	BodySpans spans;
+	spans.first = { ring + head, firstSize };
+	spans.second = { ring, length - firstSize };
+	return spans;
+}
+
+const uint8_t* SnakeBatch::GetOccupancy(int game) const
+{
+	return m_occupied.data() + size_t(game) * size_t(m_occStride);
+}
@@ -0,0 +1,117 @@
+#include <game/SnakeBatchKernels.h>
+
+#if defined(CROW_ARCH_X86)
+#include <immintrin.h>
+#endif
+
+void PlanStepScalar(const SnakeBatchKernelArgs& a, int begin, int end)
+{
+	for (int i = begin; i < end; ++i)
+	{
+		if (a.state[i] != 0)
+		{
+			a.outcome[i] = StepSkip;
+			continue;
+		}
+
+		// SetPendingDir: reject instant reverse (Up/Down, Left/Right differ in bit 0)
+		if (a.actions && (a.actions[i] ^ a.dir[i]) != 1)
+			a.pendingDir[i] = a.actions[i];
+
+		const int dir = a.pendingDir[i];
+		a.dir[i] = dir;
+
+		int x = a.headX[i];
+		int y = a.headY[i];
+		switch (dir)
+		{
+		case 0: y -= 1; break; // Up
+		case 1: y += 1; break; // Down
+		case 2: x -= 1; break; // Left
+		case 3: x += 1; break; // Right
+		}
+
+		const int cell = y * a.gridW + x;
+		a.nextX[i] = x;
+		a.nextY[i] = y;
+
+		if (unsigned(x) >= unsigned(a.gridW) || unsigned(y) >= unsigned(a.gridH) ||
+			a.occupied[size_t(i) * size_t(a.occStride) + cell])
+			a.outcome[i] = StepDie;
+		else
+			a.outcome[i] = (cell == a.foodCell[i]) ? StepEat : StepMove;
+	}
+}
+
+#if defined(CROW_ARCH_X86)
+CROW_TARGET("avx2")
+void PlanStepAvx2(const SnakeBatchKernelArgs& a, int begin, int end)
+{
+	// Direction -> delta tables, indexed by dir (lanes 4..7 unused)
+	const __m256i dxTable = _mm256_setr_epi32(0, 0, -1, 1, 0, 0, 0, 0);
+	const __m256i dyTable = _mm256_setr_epi32(-1, 1, 0, 0, 0, 0, 0, 0);
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i minusOne = _mm256_set1_epi32(-1);
+	const __m256i gridW = _mm256_set1_epi32(a.gridW);
+	const __m256i gridH = _mm256_set1_epi32(a.gridH);
+	const __m256i byteMask = _mm256_set1_epi32(0xFF);
+	const __m256i laneIdx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	const __m256i occStride = _mm256_set1_epi32(a.occStride);
+
+	int i = begin;
+	for (; i + 8 <= end; i += 8)
+	{
+		const __m256i state = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(a.state + i)));
+		const __m256i alive = _mm256_cmpeq_epi32(state, zero);
+
+		__m256i dir = _mm256_loadu_si256((const __m256i*)(a.dir + i));
+		__m256i pending = _mm256_loadu_si256((const __m256i*)(a.pendingDir + i));
+
+		if (a.actions)
+		{
+			const __m256i act = _mm256_loadu_si256((const __m256i*)(a.actions + i));
+			const __m256i reverse = _mm256_cmpeq_epi32(_mm256_xor_si256(act, dir), one);
+			const __m256i take = _mm256_andnot_si256(reverse, alive);
+			pending = _mm256_blendv_epi8(pending, act, take);
+			_mm256_storeu_si256((__m256i*)(a.pendingDir + i), pending);
+		}
+
+		dir = _mm256_blendv_epi8(dir, pending, alive);
+		_mm256_storeu_si256((__m256i*)(a.dir + i), dir);
+
+		const __m256i x = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(a.headX + i)),
+			_mm256_permutevar8x32_epi32(dxTable, dir));
+		const __m256i y = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(a.headY + i)),
+			_mm256_permutevar8x32_epi32(dyTable, dir));
+
+		// 0 <= x < W && 0 <= y < H
+		const __m256i inX = _mm256_and_si256(_mm256_cmpgt_epi32(x, minusOne), _mm256_cmpgt_epi32(gridW, x));
+		const __m256i inY = _mm256_and_si256(_mm256_cmpgt_epi32(y, minusOne), _mm256_cmpgt_epi32(gridH, y));
+		const __m256i inside = _mm256_and_si256(inX, inY);
+
+		_mm256_storeu_si256((__m256i*)(a.nextX + i), x);
+		_mm256_storeu_si256((__m256i*)(a.nextY + i), y);
+		const __m256i cell = _mm256_add_epi32(_mm256_mullo_epi32(y, gridW), x);
+
+		// Occupancy gather only for lanes that are alive and on the board
+		const __m256i gameIdx = _mm256_add_epi32(_mm256_set1_epi32(i), laneIdx);
+		const __m256i offset = _mm256_add_epi32(_mm256_mullo_epi32(gameIdx, occStride), cell);
+		const __m256i gatherMask = _mm256_and_si256(alive, inside);
+		__m256i occ = _mm256_mask_i32gather_epi32(zero, (const int*)a.occupied, offset, gatherMask, 1);
+		occ = _mm256_and_si256(occ, byteMask);
+
+		const __m256i blocked = _mm256_or_si256(_mm256_xor_si256(inside, minusOne),
+			_mm256_xor_si256(_mm256_cmpeq_epi32(occ, zero), minusOne));
+		const __m256i eats = _mm256_cmpeq_epi32(cell, _mm256_loadu_si256((const __m256i*)(a.foodCell + i)));
+
+		// Skip(0) / Move(1) / Eat(2) / Die(3)
+		__m256i outcome = _mm256_blendv_epi8(_mm256_set1_epi32(StepMove), _mm256_set1_epi32(StepEat), eats);
+		outcome = _mm256_blendv_epi8(outcome, _mm256_set1_epi32(StepDie), blocked);
+		outcome = _mm256_and_si256(outcome, alive);
+		_mm256_storeu_si256((__m256i*)(a.outcome + i), outcome);
+	}
+
+	PlanStepScalar(a, i, end);
+}
+#endif
@@ -0,0 +1,217 @@
+#include <game/SnakeEvolution.h>
+#include <game/SnakeGame.h>
+#include <engine/WorkStealingPool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+	// Spread of the initial weights
+	const float kInitSigma = 0.5f;
+}
+
+SnakeEvolution::SnakeEvolution(WorkStealingPool& pool, const EvolutionConfig& config)
+	: m_pool(pool), m_config(config), m_params(SnakeMlp::GetParamCount()),
+	m_cells(config.gridW * config.gridH),
+	m_starveSteps(config.starveSteps > 0 ? config.starveSteps : config.gridW * config.gridH),
+	m_generationSeed(0), m_rng(config.seed)
+{
+	m_config.population = std::max(2, m_config.population);
+	m_config.gamesPerGenome = std::max(1, m_config.gamesPerGenome);
+	m_config.elite = std::min(std::max(0, m_config.elite), m_config.population);
+	m_config.tournament = std::max(1, m_config.tournament);
+
+	const size_t genes = size_t(m_config.population) * size_t(m_params);
+	m_population.resize(genes);
+	m_next.resize(genes);
+	for (float& g : m_population)
+		g = Gaussian() * kInitSigma;
+
+	m_fitness.resize(size_t(m_config.population));
+	m_meanScore.resize(size_t(m_config.population));
+	m_best.assign(m_population.begin(), m_population.begin() + m_params);
+
+	const int games = m_config.gamesPerGenome;
+	for (int i = 0; i < m_pool.GetThreadCount(); ++i)
+	{
+		auto w = std::make_unique<Worker>(games);
+		for (int g = 0; g < games; ++g)
+			w->games.push_back(std::make_unique<SnakeGame>(m_config.gridW, m_config.gridH));
+		w->scores.resize(size_t(games) * SnakeMlp::kOutputs);
+		w->live.resize(size_t(games));
+		w->hungry.resize(size_t(games));
+		w->steps.resize(size_t(games));
+		w->lastLength.resize(size_t(games));
+		m_workers.push_back(std::move(w));
+	}
+}
+
+SnakeEvolution::~SnakeEvolution() = default;
+
+SnakeEvolution::Worker::Worker(int games)
+	: scratch(games)
+{
+}
+
+void SnakeEvolution::SetKernel(SnakeMlpKernel kernel)
+{
+	for (auto& w : m_workers)
+		w->mlp.SetKernel(kernel);
+}
+
+const GenerationStats& SnakeEvolution::RunGeneration()
+{
+	auto begin = std::chrono::steady_clock::now();
+
+	for (auto& w : m_workers)
+	{
+		w->totalSteps = 0;
+		w->maxScore = 0;
+	}
+	m_generationSeed = m_rng.Next();
+
+	m_pool.ParallelFor(0, m_config.population, 1,
+		[this](int64_t first, int64_t last, int worker)
+		{
+			for (int64_t i = first; i < last; ++i)
+				Evaluate(int(i), *m_workers[size_t(worker)]);
+		});
+
+	std::vector<int> ranked(size_t(m_config.population));
+	std::iota(ranked.begin(), ranked.end(), 0);
+	std::stable_sort(ranked.begin(), ranked.end(),
+		[this](int a, int b) { return m_fitness[size_t(a)] > m_fitness[size_t(b)]; });
+
+	const int best = ranked[0];
+	m_best.assign(Genome(best), Genome(best) + m_params);
+
+	m_stats.generation++;
+	m_stats.bestFitness = m_fitness[size_t(best)];
+	m_stats.bestScore = m_meanScore[size_t(best)];
+	m_stats.meanFitness = float(std::accumulate(m_fitness.begin(), m_fitness.end(), 0.0) / double(m_fitness.size()));
+	m_stats.steps = 0;
+	m_stats.maxScore = 0;
+	for (const auto& w : m_workers)
+	{
+		m_stats.steps += w->totalSteps;
+		m_stats.maxScore = std::max(m_stats.maxScore, w->maxScore);
+	}
+
+	Breed(ranked);
+	m_stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	return m_stats;
+}
+
+void SnakeEvolution::Evaluate(int genome, Worker& w)
+{
+	const int games = m_config.gamesPerGenome;
+	w.mlp.SetParams(Genome(genome));
+
+	int live = games;
+	for (int g = 0; g < games; ++g)
+	{
+		w.games[size_t(g)]->Reset(m_generationSeed + uint64_t(g));
+		w.live[size_t(g)] = g;
+		w.hungry[size_t(g)] = 0;
+		w.steps[size_t(g)] = 0;
+		w.lastLength[size_t(g)] = w.games[size_t(g)]->GetLength();
+	}
+
+	while (live > 0)
+	{
+		// One feature row per live game, one batched forward pass
+		for (int r = 0; r < live; ++r)
+			SnakeMlp::ComputeFeatures(*w.games[size_t(w.live[size_t(r)])],
+				w.scratch.features.data() + size_t(r) * SnakeMlp::kInputs);
+		w.mlp.Forward(w.scratch.features.data(), live, w.scores.data(), w.scratch);
+
+		for (int r = 0; r < live; )
+		{
+			const int g = w.live[size_t(r)];
+			SnakeGame& game = *w.games[size_t(g)];
+			game.SetPendingDir(SnakeMlp::PickDir(w.scores.data() + size_t(r) * SnakeMlp::kOutputs));
+			game.Tick();
+			w.steps[size_t(g)]++;
+
+			const int length = game.GetLength();
+			w.hungry[size_t(g)] = length == w.lastLength[size_t(g)] ? w.hungry[size_t(g)] + 1 : 0;
+			w.lastLength[size_t(g)] = length;
+
+			if (game.IsGameOver() || w.hungry[size_t(g)] >= m_starveSteps)
+			{
+				// Swap-remove; the moved row's scores move with it
+				--live;
+				w.live[size_t(r)] = w.live[size_t(live)];
+				std::copy_n(w.scores.data() + size_t(live) * SnakeMlp::kOutputs, SnakeMlp::kOutputs,
+					w.scores.data() + size_t(r) * SnakeMlp::kOutputs);
+				continue;
+			}
+			++r;
+		}
+	}
+
+	float fitness = 0.0f, score = 0.0f;
+	for (int g = 0; g < games; ++g)
+	{
+		const int s = w.games[size_t(g)]->GetScore();
+		const float steps = float(w.steps[size_t(g)]);
+		fitness += float(s) + steps / (steps + float(m_cells));
+		score += float(s);
+		w.totalSteps += w.steps[size_t(g)];
+		w.maxScore = std::max(w.maxScore, s);
+	}
+	m_fitness[size_t(genome)] = fitness / float(games);
+	m_meanScore[size_t(genome)] = score / float(games);
+}
+
+void SnakeEvolution::Breed(const std::vector<int>& ranked)
+{
+	// rank[i] = position of genome i, for tournaments
+	std::vector<int> rank(ranked.size());
+	for (size_t i = 0; i < ranked.size(); ++i)
+		rank[size_t(ranked[i])] = int(i);
+
+	const size_t params = size_t(m_params);
+	for (int i = 0; i < m_config.population; ++i)
+	{
+		float* child = m_next.data() + size_t(i) * params;
+		if (i < m_config.elite)
+		{
+			std::copy_n(Genome(ranked[size_t(i)]), params, child);
+			continue;
+		}
+
+		const float* a = Genome(Tournament(rank));
+		const float* b = Genome(Tournament(rank));
+		for (size_t k = 0; k < params; ++k)
+		{
+			child[k] = (m_rng.Next() & 1) ? a[k] : b[k];
+			if (m_rng.NextFloat() < m_config.mutationRate)
+				child[k] += Gaussian() * m_config.mutationSigma;
+		}
+	}
+
+	m_population.swap(m_next);
+}
+
+int SnakeEvolution::Tournament(const std::vector<int>& rank)
+{
+	int best = int(m_rng.NextBelow(uint32_t(m_config.population)));
+	for (int k = 1; k < m_config.tournament; ++k)
+	{
+		const int other = int(m_rng.NextBelow(uint32_t(m_config.population)));
+		if (rank[size_t(other)] < rank[size_t(best)]) best = other;
+	}
+	return best;
+}
+
+float SnakeEvolution::Gaussian()
+{
+	// Box-Muller; 1 - u keeps the log argument above zero
+	const float u = 1.0f - m_rng.NextFloat();
+	const float v = m_rng.NextFloat();
+	return std::sqrt(-2.0f * std::log(u)) * std::cos(6.2831853f * v);
+}
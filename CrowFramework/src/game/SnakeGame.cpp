@@ -1,48 +1,173 @@
 #include <game/SnakeGame.h>
+#include <game/LevelMap.h>
+#include <game/SnakeReplay.h>
+#include <game/SnakeSnapshot.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+	// One key table per board size for the whole process: instances agree
+	// on hashes, and hundreds of games don't each drag a private table
+	// through the cache
+	std::shared_ptr<const std::vector<uint64_t>> SharedZobristKeys(size_t cells)
+	{
+		static std::mutex mutex;
+		static std::map<size_t, std::weak_ptr<const std::vector<uint64_t>>> cache;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		std::shared_ptr<const std::vector<uint64_t>> keys = cache[cells].lock();
+		if (!keys)
+		{
+			auto table = std::make_shared<std::vector<uint64_t>>(4 + cells * 4);
+			SnakeRng rng(0x2B0B21u);
+			for (uint64_t& k : *table)
+				k = rng.Next();
 
-SnakeGame::SnakeGame(int gridW, int gridH)
+			keys = table;
+			cache[cells] = keys;
+		}
+		return keys;
+	}
+
+	// Open-board wall bitset, all zero; shared the same way, so copies of
+	// a game keep a valid m_walls
+	std::shared_ptr<const std::vector<uint64_t>> SharedNoWalls(size_t cells)
+	{
+		static std::mutex mutex;
+		static std::map<size_t, std::weak_ptr<const std::vector<uint64_t>>> cache;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		std::shared_ptr<const std::vector<uint64_t>> bits = cache[cells].lock();
+		if (!bits)
+		{
+			bits = std::make_shared<const std::vector<uint64_t>>((cells + 63) / 64, 0);
+			cache[cells] = bits;
+		}
+		return bits;
+	}
+}
+
+SnakeGame::SnakeGame(int gridW, int gridH, uint64_t seed)
 	: m_gridW(gridW), m_gridH(gridH),
+	m_walls(nullptr),
+	m_occupied(size_t(gridW) * size_t(gridH), 0),
+	m_freeCells(size_t(gridW) * size_t(gridH)),
+	m_freePos(size_t(gridW) * size_t(gridH)),
+	m_freeCount(0),
 	m_dir(Dir::Right), m_pendingDir(Dir::Right),
-	m_gameOver(false),
-	m_stepTime(0.2f), m_acc(0.0f)
+	m_gameOver(false), m_won(false), m_deathCause(DeathCause::None),
+	m_stepTime(0.2f), m_acc(0.0f),
+	m_seed(seed), m_recorder(nullptr),
+	m_zobristKeys(SharedZobristKeys(size_t(gridW) * size_t(gridH))),
+	m_zobrist(m_zobristKeys->data()), m_hash(0),
+	m_noWalls(SharedNoWalls(size_t(gridW) * size_t(gridH)))
 {
+	// Reset() puts the tail at cx - 2
+	assert(gridW >= 4 && gridH >= 1);
+	m_walls = m_noWalls->data();
+
+	// Body can never outgrow the board, so this is the only allocation
+	m_snake.Init(gridW * gridH);
 	Reset();
 }
 
+SnakeGame::SnakeGame(std::shared_ptr<const LevelMap> level, uint64_t seed)
+	: SnakeGame(level->GetGridW(), level->GetGridH(), seed)
+{
+	SetLevel(std::move(level));
+}
+
 void SnakeGame::Reset()
 {
 	// Reset = recreate initial game state
-	m_snake.clear();
+	m_rng.Seed(m_seed);
+	if (m_recorder) m_recorder->Begin(m_gridW, m_gridH, m_seed);
+	m_snake.Clear();
+	std::fill(m_occupied.begin(), m_occupied.end(), uint8_t(0));
+
+	// Every open cell in index order (an open board gives 0, 1, 2, ...)
+	m_freeCount = 0;
+	const int cells = int(m_freeCells.size());
+	for (int idx = 0; idx < cells; ++idx)
+	{
+		if ((m_walls[idx >> 6] >> (idx & 63)) & 1)
+		{
+			m_freePos[idx] = -1;
+			continue;
+		}
+		m_freeCells[m_freeCount] = idx;
+		m_freePos[idx] = m_freeCount++;
+	}
 	m_gameOver = false;
+	m_won = false;
+	m_deathCause = DeathCause::None;
 	m_acc = 0.0f;
+	m_events.Clear();
 
 	m_dir = Dir::Right;
 	m_pendingDir = Dir::Right;
+	m_food = { -1, -1 };
+	m_hash = DirKey(m_dir);
 
 	int cx = m_gridW / 2;
 	int cy = m_gridH / 2;
 
-	// front = head
-	m_snake.push_back({ cx,     cy });
-	m_snake.push_back({ cx - 1, cy });
-	m_snake.push_back({ cx - 2, cy });
+	// front = head, so push tail first
+	const Cell start[] = { { cx - 2, cy }, { cx - 1, cy }, { cx, cy } };
+	for (const Cell& part : start)
+	{
+		m_snake.PushFront(part);
+		Occupy(part);
+	}
+	m_hash ^= Key(ZHead, m_snake.Front()) ^ Key(ZTail, m_snake.Back());
 
 	SpawnFood();
 }
 
-void SnakeGame::Update(float dt)
+void SnakeGame::Reset(uint64_t seed)
 {
+	m_seed = seed;
+	Reset();
+}
+
+const StepEventList& SnakeGame::Update(float dt)
+{
+	m_events.Clear();
+
 	// Stop advancing game logic after death
-	if (m_gameOver) return;
+	if (m_gameOver) return m_events;
 
 	m_acc += dt;
 
-	// Fixed-step movement
-	while (m_acc >= m_stepTime)
+	// Fixed-step movement; records go straight into the list, steps past
+	// its capacity only mark it overflowed
+	while (m_acc >= m_stepTime && !m_gameOver)
 	{
-		Step();
+		if (m_events.count < StepEventList::kCapacity)
+			Step(m_events.events[m_events.count++]);
+		else
+		{
+			m_events.overflowed = true;
+			Step(m_event);
+		}
 		m_acc -= m_stepTime;
 	}
+	return m_events;
+}
+
+const StepEvent& SnakeGame::Tick()
+{
+	if (m_gameOver)
+		m_event = StepEvent();
+	else
+		Step(m_event);
+	return m_event;
 }
 
 void SnakeGame::SetPendingDir(Dir dir)
@@ -57,14 +182,34 @@ bool SnakeGame::IsGameOver() const
 	return m_gameOver;
 }
 
+bool SnakeGame::IsWon() const
+{
+	return m_won;
+}
+
+DeathCause SnakeGame::GetDeathCause() const
+{
+	return m_deathCause;
+}
+
 const Cell& SnakeGame::GetHead() const
 {
-	return m_snake.front();
+	return m_snake.Front();
+}
+
+const Cell& SnakeGame::GetTail() const
+{
+	return m_snake.Back();
+}
+
+BodySpans SnakeGame::GetBody() const
+{
+	return m_snake.Spans();
 }
 
-const std::deque<Cell>& SnakeGame::GetBody() const
+int SnakeGame::GetLength() const
 {
-	return m_snake;
+	return m_snake.Size();
 }
 
 const Cell& SnakeGame::GetFood() const
@@ -72,6 +217,16 @@ const Cell& SnakeGame::GetFood() const
 	return m_food;
 }
 
+Dir SnakeGame::GetDir() const
+{
+	return m_dir;
+}
+
+bool SnakeGame::IsBlocked(const Cell& c) const
+{
+	return HitsWall(c) || HitsSelf(c);
+}
+
 int SnakeGame::GetGridW() const
 {
 	return m_gridW;
@@ -84,13 +239,156 @@ int SnakeGame::GetGridH() const
 
 int SnakeGame::GetScore() const
 {
-	return int(m_snake.size()) - 3;
+	return m_snake.Size() - 3;
+}
+
+uint64_t SnakeGame::GetSeed() const
+{
+	return m_seed;
+}
+
+float SnakeGame::GetStepTime() const
+{
+	return m_stepTime;
+}
+
+void SnakeGame::SetRecorder(SnakeReplay* replay)
+{
+	m_recorder = replay;
+}
+
+bool SnakeGame::SetLevel(std::shared_ptr<const LevelMap> level)
+{
+	if (level && (level->GetGridW() != m_gridW || level->GetGridH() != m_gridH))
+		return false;
+
+	m_level = std::move(level);
+	m_walls = m_level ? m_level->GetWalls() : m_noWalls->data();
+	Reset();
+	return true;
+}
+
+const std::shared_ptr<const LevelMap>& SnakeGame::GetLevel() const
+{
+	return m_level;
+}
+
+size_t SnakeGame::GetSnapshotSize() const
+{
+	// Worst case for every variable-length array, rounded to keep slots aligned
+	const size_t cells = m_occupied.size();
+	const size_t size = sizeof(SnakeSnapshotHeader) + cells * (2 * sizeof(int) + sizeof(Cell) + 1);
+	return (size + 7) & ~size_t(7);
+}
+
+void SnakeGame::Save(void* slot) const
+{
+	const size_t cells = m_occupied.size();
+
+	SnakeSnapshotHeader& h = *static_cast<SnakeSnapshotHeader*>(slot);
+	h.gridW = m_gridW;
+	h.gridH = m_gridH;
+	h.length = m_snake.Size();
+	h.freeCount = m_freeCount;
+	h.food = m_food;
+	h.dir = uint8_t(m_dir);
+	h.pendingDir = uint8_t(m_pendingDir);
+	h.gameOver = m_gameOver;
+	h.won = m_won;
+	h.deathCause = uint8_t(m_deathCause);
+	std::memset(h.pad, 0, sizeof(h.pad));
+	h.acc = m_acc;
+	h.seed = m_seed;
+	std::memcpy(h.rng, m_rng.s, sizeof(h.rng));
+	h.hash = m_hash;
+
+	// Only the live prefix of the free list and the body are copied
+	unsigned char* p = static_cast<unsigned char*>(slot) + sizeof(SnakeSnapshotHeader);
+	std::memcpy(p, m_freePos.data(), cells * sizeof(int));
+	p += cells * sizeof(int);
+	std::memcpy(p, m_freeCells.data(), size_t(m_freeCount) * sizeof(int));
+	p += size_t(m_freeCount) * sizeof(int);
+	m_snake.CopyTo(reinterpret_cast<Cell*>(p));
+	p += size_t(m_snake.Size()) * sizeof(Cell);
+	std::memcpy(p, m_occupied.data(), cells);
+}
+
+void SnakeGame::Restore(const void* slot)
+{
+	const size_t cells = m_occupied.size();
+
+	const SnakeSnapshotHeader& h = *static_cast<const SnakeSnapshotHeader*>(slot);
+	assert(h.gridW == m_gridW && h.gridH == m_gridH);
+
+	m_freeCount = h.freeCount;
+	m_food = h.food;
+	m_dir = Dir(h.dir);
+	m_pendingDir = Dir(h.pendingDir);
+	m_gameOver = h.gameOver != 0;
+	m_won = h.won != 0;
+	m_deathCause = DeathCause(h.deathCause);
+	m_acc = h.acc;
+	m_seed = h.seed;
+	std::memcpy(m_rng.s, h.rng, sizeof(h.rng));
+	m_hash = h.hash;
+	m_events.Clear();
+
+	const unsigned char* p = static_cast<const unsigned char*>(slot) + sizeof(SnakeSnapshotHeader);
+	std::memcpy(m_freePos.data(), p, cells * sizeof(int));
+	p += cells * sizeof(int);
+	std::memcpy(m_freeCells.data(), p, size_t(h.freeCount) * sizeof(int));
+	p += size_t(h.freeCount) * sizeof(int);
+	m_snake.Assign(reinterpret_cast<const Cell*>(p), h.length);
+	p += size_t(h.length) * sizeof(Cell);
+	std::memcpy(m_occupied.data(), p, cells);
 }
 
-void SnakeGame::Step()
+uint64_t SnakeGame::GetHash() const
+{
+	return m_hash;
+}
+
+uint64_t SnakeGame::ComputeHash() const
+{
+	uint64_t hash = DirKey(m_dir);
+	m_snake.Spans().ForEach([&](const Cell& c) { hash ^= Key(ZOccupied, c); });
+	if (m_snake.Size() > 0)
+		hash ^= Key(ZHead, m_snake.Front()) ^ Key(ZTail, m_snake.Back());
+	if (m_food.x >= 0)
+		hash ^= Key(ZFood, m_food);
+	return hash;
+}
+
+uint64_t SnakeGame::ComputeStateHash() const
+{
+	uint64_t hash = m_hash;
+	auto mix = [&hash](uint64_t v)
+		{
+			hash = (hash ^ v) * 0x9E3779B97F4A7C15ull;
+			hash ^= hash >> 29;
+		};
+
+	// Zobrist part has the occupied set; order and free list are not in it
+	m_snake.Spans().ForEach([&](const Cell& c) { mix(uint64_t(CellIndex(c))); });
+	mix(uint64_t(m_freeCount) << 32 | uint64_t(m_dir));
+	for (int i = 0; i < m_freeCount; ++i)
+		mix(uint64_t(m_freeCells[i]));
+	for (uint64_t w : m_rng.s)
+		mix(w);
+	return hash;
+}
+
+void SnakeGame::Step(StepEvent& e)
 {
 	// Commit direction once per step
+	if (m_pendingDir != m_dir)
+		m_hash ^= DirKey(m_dir) ^ DirKey(m_pendingDir);
 	m_dir = m_pendingDir;
+	if (m_recorder) m_recorder->Append(m_dir);
+
+	e.dir = m_dir;
+	e.removed = { -1, -1 };
+	e.food = m_food;
 
 	Cell newHead = NextHead();
 
@@ -98,30 +396,39 @@ void SnakeGame::Step()
 	if (HitsWall(newHead) || HitsSelf(newHead))
 	{
 		m_gameOver = true;
+		m_deathCause = HitsWall(newHead) ? DeathCause::Wall : DeathCause::Self;
+		e.added = { -1, -1 };
+		e.flags = StepEvent::Died;
+		e.cause = m_deathCause;
 		return;
 	}
 
-	m_snake.push_front(newHead);
+	m_hash ^= Key(ZHead, m_snake.Front()) ^ Key(ZHead, newHead);
+	m_snake.PushFront(newHead);
+	Occupy(newHead);
+	e.added = newHead;
+	e.cause = DeathCause::None;
 
 	if (EatsFood(newHead))
+	{
 		SpawnFood();
+		e.food = m_food;
+		e.flags = uint8_t(StepEvent::Moved | StepEvent::Grew | StepEvent::FoodMoved | (m_won ? StepEvent::Won : 0));
+	}
 	else
-		m_snake.pop_back();
+	{
+		e.removed = m_snake.Back();
+		e.flags = StepEvent::Moved;
+		m_hash ^= Key(ZTail, m_snake.Back());
+		Release(m_snake.Back());
+		m_snake.PopBack();
+		m_hash ^= Key(ZTail, m_snake.Back());
+	}
 }
 
 Cell SnakeGame::NextHead() const
 {
-	Cell head = m_snake.front();
-
-	switch (m_dir)
-	{
-	case Dir::Up:    head.y -= 1; break;
-	case Dir::Down:  head.y += 1; break;
-	case Dir::Left:  head.x -= 1; break;
-	case Dir::Right: head.x += 1; break;
-	}
-
-	return head;
+	return Neighbor(m_snake.Front(), m_dir);
 }
 
 bool SnakeGame::IsOpposite(Dir a, Dir b) const
@@ -134,17 +441,19 @@ bool SnakeGame::IsOpposite(Dir a, Dir b) const
 
 bool SnakeGame::HitsWall(const Cell& c) const
 {
-	return c.x < 0 || c.x >= m_gridW ||
-		c.y < 0 || c.y >= m_gridH;
+	if (c.x < 0 || c.x >= m_gridW ||
+		c.y < 0 || c.y >= m_gridH)
+		return true;
+
+	// Open boards test against m_noWalls, so there is no level branch
+	const int idx = CellIndex(c);
+	return (m_walls[idx >> 6] >> (idx & 63)) & 1;
 }
 
 bool SnakeGame::HitsSelf(const Cell& c) const
 {
-	for (const Cell& part : m_snake)
-		if (part.x == c.x && part.y == c.y)
-			return true;
-
-	return false;
+	// Tail is still occupied here, same as before the occupancy grid
+	return m_occupied[CellIndex(c)] != 0;
 }
 
 bool SnakeGame::EatsFood(const Cell& c) const
@@ -154,30 +463,61 @@ bool SnakeGame::EatsFood(const Cell& c) const
 
 void SnakeGame::SpawnFood()
 {
-	// Random empty cell
-	unsigned seed = m_rngSeed;
-	int fx, fy;
-	bool valid;
+	if (m_food.x >= 0)
+		m_hash ^= Key(ZFood, m_food);
 
-	do
+	// Board full = nothing left to eat, the run is won
+	if (m_freeCount == 0)
 	{
-		seed = (214013 * seed + 2531011);
-		fx = (seed >> 16) % m_gridW;
+		m_gameOver = true;
+		m_won = true;
+		m_food = { -1, -1 };
+		return;
+	}
 
-		seed = (214013 * seed + 2531011);
-		fy = (seed >> 16) % m_gridH;
+	// One draw picks a uniform empty cell
+	int slot = int(m_rng.NextBelow(uint32_t(m_freeCount)));
+	int idx = m_freeCells[slot];
 
-		valid = true;
-		for (const Cell& part : m_snake)
-		{
-			if (part.x == fx && part.y == fy)
-			{
-				valid = false;
-				break;
-			}
-		}
-	} while (!valid);
+	m_food = { idx % m_gridW, idx / m_gridW };
+	m_hash ^= Key(ZFood, m_food);
+}
+
+int SnakeGame::CellIndex(const Cell& c) const
+{
+	return c.y * m_gridW + c.x;
+}
 
-	m_food = { fx, fy };
-	m_rngSeed = seed;
+void SnakeGame::Occupy(const Cell& c)
+{
+	int idx = CellIndex(c);
+	m_occupied[idx] = 1;
+	m_hash ^= m_zobrist[4 + size_t(idx) * 4 + ZOccupied];
+
+	// Swap-remove from the free list
+	int slot = m_freePos[idx];
+	int last = m_freeCells[--m_freeCount];
+	m_freeCells[slot] = last;
+	m_freePos[last] = slot;
+	m_freePos[idx] = -1;
+}
+
+void SnakeGame::Release(const Cell& c)
+{
+	int idx = CellIndex(c);
+	m_occupied[idx] = 0;
+	m_hash ^= m_zobrist[4 + size_t(idx) * 4 + ZOccupied];
+
+	m_freeCells[m_freeCount] = idx;
+	m_freePos[idx] = m_freeCount++;
+}
+
+uint64_t SnakeGame::Key(ZobristKind kind, const Cell& c) const
+{
+	return m_zobrist[4 + size_t(CellIndex(c)) * 4 + kind];
+}
+
+uint64_t SnakeGame::DirKey(Dir d) const
+{
+	return m_zobrist[size_t(d)];
 }
\ No newline at end of file
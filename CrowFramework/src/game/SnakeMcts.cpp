@@ -0,0 +1,281 @@
+#include <game/SnakeMcts.h>
+#include <game/SnakeGame.h>
+#include <engine/WorkStealingPool.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const int64_t kValueOne = 1 << 16;
+
+	// children sentinels; real first-child indices stay below them
+	const uint32_t kExpanding = 0xFFFFFFFFu;
+	const uint32_t kNoRoom = 0xFFFFFFFEu;
+
+	int Distance(const Cell& a, const Cell& b)
+	{
+		return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+	}
+}
+
+SnakeMcts::SnakeMcts(WorkStealingPool& pool, const SnakeGame& game, const MctsConfig& config)
+	: m_pool(pool), m_config(config),
+	m_nodes(new Node[size_t(std::max(config.maxNodes, 5))]),
+	m_nodeCount(0),
+	m_root((game.GetSnapshotSize() + 7) / 8)
+{
+	m_config.maxNodes = std::max(config.maxNodes, 5);
+
+	for (int i = 0; i < pool.GetThreadCount(); ++i)
+	{
+		auto w = std::make_unique<Worker>();
+		w->game = std::make_unique<SnakeGame>(game.GetGridW(), game.GetGridH());
+		w->game->SetLevel(game.GetLevel());
+		w->rng = SnakeRng::ForStream(config.seed, uint64_t(i));
+		w->path.reserve(256);
+		m_workers.push_back(std::move(w));
+	}
+}
+
+SnakeMcts::~SnakeMcts() = default;
+
+Dir SnakeMcts::Decide(const SnakeGame& game)
+{
+	if (game.IsGameOver()) return game.GetDir();
+
+	const Clock::time_point start = Clock::now();
+	const Clock::time_point deadline = start +
+		std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(m_config.budget));
+
+	game.Save(m_root.data());
+
+	Node& root = m_nodes[0];
+	root.value.store(0, std::memory_order_relaxed);
+	root.visits.store(0, std::memory_order_relaxed);
+	root.children.store(0, std::memory_order_relaxed);
+	m_nodeCount.store(1, std::memory_order_relaxed);
+
+	for (auto& w : m_workers)
+	{
+		w->rollouts = 0;
+		w->maxDepth = 0;
+	}
+
+	// One long-running task per thread; each checks the clock itself. A
+	// task that starts late (pool busy elsewhere) just finds the deadline
+	// passed. Called from a pool task: search here, submitting and waiting
+	// could block on tasks queued behind the caller
+	const int self = m_pool.CurrentWorker();
+	if (self >= 0)
+		Search(*m_workers[size_t(self)], deadline);
+	else
+	{
+		const int tasks = m_pool.GetThreadCount();
+		{
+			std::lock_guard<std::mutex> lock(m_doneMutex);
+			m_running = tasks;
+		}
+		for (int i = 0; i < tasks; ++i)
+			m_pool.Submit([this, deadline](int worker)
+				{
+					Search(*m_workers[size_t(worker)], deadline);
+					std::lock_guard<std::mutex> lock(m_doneMutex);
+					if (--m_running == 0) m_done.notify_one();
+				});
+
+		std::unique_lock<std::mutex> lock(m_doneMutex);
+		m_done.wait(lock, [this] { return m_running == 0; });
+	}
+
+	m_stats = MctsStats();
+	for (const auto& w : m_workers)
+	{
+		m_stats.rollouts += w->rollouts;
+		m_stats.maxDepth = std::max(m_stats.maxDepth, w->maxDepth);
+	}
+	m_stats.nodes = int(std::min(m_nodeCount.load(), uint32_t(m_config.maxNodes)));
+	m_stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	// Most visited legal move; no expansion at all keeps going straight
+	Dir best = game.GetDir();
+	const uint32_t first = root.children.load(std::memory_order_acquire);
+	if (first == 0 || first >= kNoRoom) return best;
+
+	int mostVisits = -1;
+	for (int i = 0; i < 4; ++i)
+	{
+		if ((i ^ int(game.GetDir())) == 1) continue;
+
+		const int v = m_nodes[first + uint32_t(i)].visits.load(std::memory_order_relaxed);
+		if (v > mostVisits)
+		{
+			mostVisits = v;
+			best = Dir(i);
+		}
+	}
+	return best;
+}
+
+void SnakeMcts::Drive(SnakeGame& game)
+{
+	game.SetPendingDir(Decide(game));
+}
+
+void SnakeMcts::Search(Worker& w, Clock::time_point deadline)
+{
+	SnakeGame& game = *w.game;
+	const int vl = m_config.virtualLoss;
+
+	for (uint64_t iter = 0;; ++iter)
+	{
+		if ((iter & 15) == 0 && Clock::now() >= deadline) break;
+
+		game.Restore(m_root.data());
+		w.path.clear();
+		w.path.push_back(0);
+		m_nodes[0].visits.fetch_add(vl, std::memory_order_relaxed);
+
+		// Selection: descend while the node has children, booking virtual
+		// loss on the way; a freshly expanded node gets one step, then rollout
+		uint32_t node = 0;
+		float meals = 0.0f;
+		float weight = 1.0f;
+		while (!game.IsGameOver())
+		{
+			uint32_t first = m_nodes[node].children.load(std::memory_order_acquire);
+			const bool expand = first == 0;
+			if (expand)
+				first = Expand(node);
+			if (first == 0 || first >= kNoRoom) break;
+
+			const uint32_t child = SelectChild(first, m_nodes[node].visits.load(std::memory_order_relaxed),
+				game.GetDir(), w.rng);
+			m_nodes[child].visits.fetch_add(vl, std::memory_order_relaxed);
+			w.path.push_back(child);
+
+			const int length = game.GetLength();
+			game.SetPendingDir(Dir(child - first));
+			game.Tick();
+			weight *= m_config.discount;
+			if (game.GetLength() != length) meals += weight;
+			node = child;
+			if (expand) break;
+		}
+
+		const int depth = int(w.path.size()) - 1;
+		const int64_t value = int64_t(Rollout(game, w.rng, depth, meals, weight) * float(kValueOne));
+
+		// Backup: the real visit replaces the virtual loss
+		for (uint32_t n : w.path)
+		{
+			m_nodes[n].visits.fetch_add(1 - vl, std::memory_order_relaxed);
+			m_nodes[n].value.fetch_add(value, std::memory_order_relaxed);
+		}
+
+		w.rollouts++;
+		w.maxDepth = std::max(w.maxDepth, depth);
+	}
+}
+
+uint32_t SnakeMcts::Expand(uint32_t node)
+{
+	uint32_t expected = 0;
+	if (!m_nodes[node].children.compare_exchange_strong(expected, kExpanding, std::memory_order_acq_rel))
+		return 0;
+
+	const uint32_t first = m_nodeCount.fetch_add(4, std::memory_order_relaxed);
+	if (uint64_t(first) + 4 > uint64_t(m_config.maxNodes))
+	{
+		m_nodes[node].children.store(kNoRoom, std::memory_order_release);
+		return 0;
+	}
+
+	for (uint32_t i = first; i < first + 4; ++i)
+	{
+		m_nodes[i].value.store(0, std::memory_order_relaxed);
+		m_nodes[i].visits.store(0, std::memory_order_relaxed);
+		m_nodes[i].children.store(0, std::memory_order_relaxed);
+	}
+
+	// Publish: readers that see first also see the cleared children
+	m_nodes[node].children.store(first, std::memory_order_release);
+	return first;
+}
+
+uint32_t SnakeMcts::SelectChild(uint32_t first, int parentVisits, Dir current, SnakeRng& rng) const
+{
+	const float logN = std::log(float(std::max(parentVisits, 1)));
+	const int start = int(rng.NextBelow(4));
+
+	uint32_t best = first;
+	float bestScore = -1.0f;
+	for (int k = 0; k < 4; ++k)
+	{
+		const int i = (start + k) & 3;
+		if ((i ^ int(current)) == 1) continue;
+
+		const Node& c = m_nodes[first + uint32_t(i)];
+		const int n = c.visits.load(std::memory_order_relaxed);
+		if (n <= 0) return first + uint32_t(i);
+
+		const float q = float(c.value.load(std::memory_order_relaxed)) / float(kValueOne) / float(n);
+		const float score = q + m_config.exploration * std::sqrt(logN / float(n));
+		if (score > bestScore)
+		{
+			bestScore = score;
+			best = first + uint32_t(i);
+		}
+	}
+	return best;
+}
+
+float SnakeMcts::Rollout(SnakeGame& game, SnakeRng& rng, int depth, float meals, float weight) const
+{
+	int steps = 0;
+	while (steps < m_config.rolloutSteps && !game.IsGameOver())
+	{
+		// Random move that does not die on the spot; half the time one
+		// that closes in on the food, if there is such a move
+		const Cell head = game.GetHead();
+		const Cell food = game.GetFood();
+		const int toFood = Distance(head, food);
+
+		Dir open[4], closer[4];
+		int openCount = 0, closerCount = 0;
+		for (int i = 0; i < 4; ++i)
+		{
+			if ((i ^ int(game.GetDir())) == 1) continue;
+
+			const Cell next = Neighbor(head, Dir(i));
+			if (game.IsBlocked(next)) continue;
+
+			open[openCount++] = Dir(i);
+			if (Distance(next, food) < toFood)
+				closer[closerCount++] = Dir(i);
+		}
+
+		Dir d = game.GetDir();
+		if (closerCount && (rng.Next() & 1))
+			d = closer[rng.NextBelow(uint32_t(closerCount))];
+		else if (openCount)
+			d = open[rng.NextBelow(uint32_t(openCount))];
+
+		const int length = game.GetLength();
+		game.SetPendingDir(d);
+		game.Tick();
+		steps++;
+		weight *= m_config.discount;
+		if (game.GetLength() != length) meals += weight;
+	}
+
+	if (game.IsWon()) return 1.0f;
+
+	// Mostly food, each meal discounted by the steps it took to get there;
+	// the rest for staying alive (dying later is better)
+	const float food = meals / (meals + 1.0f);
+	const float alive = game.IsGameOver()
+		? std::min(1.0f, float(depth + steps) / float(m_config.rolloutSteps))
+		: 1.0f;
+	return 0.25f * alive + 0.75f * food;
+}
@@ -0,0 +1,306 @@
+#include <game/SnakeMlp.h>
+#include <game/SnakeGame.h>
+#include <engine/CpuFeatures.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(CROW_ARCH_X86)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	const char kMagic[4] = { 'S', 'N', 'M', 'L' };
+	const uint32_t kVersion = 1;
+
+	// magic, version, inputs, hidden, outputs, param count
+	const size_t kHeaderSize = 4 + 4 * 5;
+
+	// Output rows padded to whole AVX2 registers
+	const int kLane = 8;
+
+	// dx, dy of the 8 feature rays: axes first, then diagonals
+	const int kRayDx[SnakeMlp::kRays] = { 0, 0, -1, 1, -1, 1, -1, 1 };
+	const int kRayDy[SnakeMlp::kRays] = { -1, 1, 0, 0, -1, -1, 1, 1 };
+
+	int RoundUp(int n)
+	{
+		return (n + kLane - 1) / kLane * kLane;
+	}
+
+	void PutU32(unsigned char* p, uint32_t v)
+	{
+		for (int i = 0; i < 4; ++i) p[i] = (unsigned char)(v >> (8 * i));
+	}
+
+	uint32_t GetU32(const unsigned char* p)
+	{
+		uint32_t v = 0;
+		for (int i = 0; i < 4; ++i) v |= uint32_t(p[i]) << (8 * i);
+		return v;
+	}
+
+	void DenseScalar(const float* w, const float* bias, int inputs, int stride,
+		const float* in, int inStride, int batch, float* out, bool relu)
+	{
+		for (int b = 0; b < batch; ++b)
+		{
+			const float* x = in + size_t(b) * size_t(inStride);
+			float* y = out + size_t(b) * size_t(stride);
+
+			for (int o = 0; o < stride; ++o)
+				y[o] = bias[o];
+			for (int i = 0; i < inputs; ++i)
+			{
+				const float xi = x[i];
+				const float* wi = w + size_t(i) * size_t(stride);
+				for (int o = 0; o < stride; ++o)
+					y[o] += xi * wi[o];
+			}
+			if (relu)
+				for (int o = 0; o < stride; ++o)
+					y[o] = y[o] > 0.0f ? y[o] : 0.0f;
+		}
+	}
+
+#if defined(CROW_ARCH_X86)
+	// Same sums in the same order as DenseScalar (separate multiply and
+	// add, no FMA), so both kernels give identical scores
+	CROW_TARGET("avx2")
+	void DenseAvx2(const float* w, const float* bias, int inputs, int stride,
+		const float* in, int inStride, int batch, float* out, bool relu)
+	{
+		const __m256 zero = _mm256_setzero_ps();
+		for (int b = 0; b < batch; ++b)
+		{
+			const float* x = in + size_t(b) * size_t(inStride);
+			float* y = out + size_t(b) * size_t(stride);
+
+			for (int o = 0; o < stride; o += kLane)
+			{
+				__m256 acc = _mm256_loadu_ps(bias + o);
+				for (int i = 0; i < inputs; ++i)
+				{
+					const __m256 wi = _mm256_loadu_ps(w + size_t(i) * size_t(stride) + size_t(o));
+					acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_set1_ps(x[i]), wi));
+				}
+				if (relu)
+					acc = _mm256_max_ps(acc, zero);
+				_mm256_storeu_ps(y + o, acc);
+			}
+		}
+	}
+#endif
+}
+
+SnakeMlpScratch::SnakeMlpScratch(int maxBatch)
+	: maxBatch(std::max(1, maxBatch)),
+	features(size_t(this->maxBatch) * size_t(SnakeMlp::kInputs)),
+	hidden1(size_t(this->maxBatch) * size_t(RoundUp(SnakeMlp::kHidden))),
+	hidden2(size_t(this->maxBatch) * size_t(RoundUp(SnakeMlp::kHidden))),
+	scores(size_t(this->maxBatch) * size_t(RoundUp(SnakeMlp::kOutputs)))
+{
+}
+
+int SnakeMlp::GetParamCount()
+{
+	return (kInputs + 1) * kHidden + (kHidden + 1) * kHidden + (kHidden + 1) * kOutputs;
+}
+
+SnakeMlp::SnakeMlp()
+	: SnakeMlp(std::vector<float>(size_t(GetParamCount()), 0.0f).data())
+{
+}
+
+SnakeMlp::SnakeMlp(const float* params)
+{
+	const int sizes[4] = { kInputs, kHidden, kHidden, kOutputs };
+	size_t offset = 0;
+	for (int l = 0; l < 3; ++l)
+	{
+		Layer& layer = m_layers[l];
+		layer.inputs = sizes[l];
+		layer.outputs = sizes[l + 1];
+		layer.stride = RoundUp(layer.outputs);
+		layer.weights = offset;
+		layer.bias = offset + size_t(layer.inputs) * size_t(layer.stride);
+		offset = layer.bias + size_t(layer.stride);
+	}
+	m_packed.assign(offset, 0.0f);
+
+	SetParams(params);
+	SetKernel(SnakeMlpKernel::Auto);
+}
+
+void SnakeMlp::SetParams(const float* params)
+{
+	m_params.assign(params, params + GetParamCount());
+
+	// Genome layout per layer: weights [input][output], then biases.
+	// Padding columns stay zero.
+	const float* p = params;
+	for (const Layer& layer : m_layers)
+	{
+		for (int i = 0; i < layer.inputs; ++i)
+			for (int o = 0; o < layer.outputs; ++o)
+				m_packed[layer.weights + size_t(i) * size_t(layer.stride) + size_t(o)] = *p++;
+		for (int o = 0; o < layer.outputs; ++o)
+			m_packed[layer.bias + size_t(o)] = *p++;
+	}
+}
+
+void SnakeMlp::SetKernel(SnakeMlpKernel kernel)
+{
+	m_kernel = SnakeMlpKernel::Scalar;
+	m_dense = &DenseScalar;
+
+#if defined(CROW_ARCH_X86)
+	if (kernel != SnakeMlpKernel::Scalar && GetCpuFeatures().avx2)
+	{
+		m_kernel = SnakeMlpKernel::Avx2;
+		m_dense = &DenseAvx2;
+	}
+#else
+	(void)kernel;
+#endif
+}
+
+void SnakeMlp::ComputeFeatures(const SnakeGame& game, float* out)
+{
+	const Cell head = game.GetHead();
+	const Cell food = game.GetFood();
+	const int w = game.GetGridW();
+	const int h = game.GetGridH();
+
+	for (int r = 0; r < kRays; ++r)
+	{
+		int wall = 0, body = 0;
+		bool seesFood = false;
+		Cell c = head;
+		for (int k = 1; ; ++k)
+		{
+			c.x += kRayDx[r];
+			c.y += kRayDy[r];
+			if (unsigned(c.x) >= unsigned(w) || unsigned(c.y) >= unsigned(h))
+			{
+				wall = k;
+				break;
+			}
+			if (!body && game.IsBlocked(c)) body = k;
+			seesFood = seesFood || (c.x == food.x && c.y == food.y);
+		}
+
+		out[r * 3 + 0] = 1.0f / float(wall);
+		out[r * 3 + 1] = body ? 1.0f / float(body) : 0.0f;
+		out[r * 3 + 2] = seesFood ? 1.0f : 0.0f;
+	}
+
+	float* dir = out + kRays * 3;
+	for (int d = 0; d < 4; ++d)
+		dir[d] = int(game.GetDir()) == d ? 1.0f : 0.0f;
+}
+
+void SnakeMlp::Forward(const float* inputs, int batch, float* scores, SnakeMlpScratch& scratch) const
+{
+	const Layer& l0 = m_layers[0];
+	const Layer& l1 = m_layers[1];
+	const Layer& l2 = m_layers[2];
+	const float* packed = m_packed.data();
+
+	for (int begin = 0; begin < batch; begin += scratch.maxBatch)
+	{
+		const int rows = std::min(scratch.maxBatch, batch - begin);
+		const float* in = inputs + size_t(begin) * size_t(kInputs);
+
+		m_dense(packed + l0.weights, packed + l0.bias, l0.inputs, l0.stride,
+			in, kInputs, rows, scratch.hidden1.data(), true);
+		m_dense(packed + l1.weights, packed + l1.bias, l1.inputs, l1.stride,
+			scratch.hidden1.data(), l0.stride, rows, scratch.hidden2.data(), true);
+		m_dense(packed + l2.weights, packed + l2.bias, l2.inputs, l2.stride,
+			scratch.hidden2.data(), l1.stride, rows, scratch.scores.data(), false);
+
+		for (int b = 0; b < rows; ++b)
+			std::memcpy(scores + size_t(begin + b) * size_t(kOutputs),
+				scratch.scores.data() + size_t(b) * size_t(l2.stride), sizeof(float) * kOutputs);
+	}
+}
+
+Dir SnakeMlp::PickDir(const float* scores)
+{
+	int best = 0;
+	for (int d = 1; d < kOutputs; ++d)
+		if (scores[d] > scores[best]) best = d;
+	return Dir(best);
+}
+
+Dir SnakeMlp::Decide(const SnakeGame& game, SnakeMlpScratch& scratch) const
+{
+	float scores[kOutputs];
+	ComputeFeatures(game, scratch.features.data());
+	Forward(scratch.features.data(), 1, scores, scratch);
+	return PickDir(scores);
+}
+
+void SnakeMlp::Drive(SnakeGame& game, SnakeMlpScratch& scratch) const
+{
+	game.SetPendingDir(Decide(game, scratch));
+}
+
+bool SnakeMlp::Save(const char* path) const
+{
+	FILE* f = std::fopen(path, "wb");
+	if (!f) return false;
+
+	unsigned char header[kHeaderSize];
+	std::memcpy(header, kMagic, 4);
+	PutU32(header + 4, kVersion);
+	PutU32(header + 8, uint32_t(kInputs));
+	PutU32(header + 12, uint32_t(kHidden));
+	PutU32(header + 16, uint32_t(kOutputs));
+	PutU32(header + 20, uint32_t(m_params.size()));
+
+	// Float bits byte by byte, same file on any host
+	std::vector<unsigned char> payload(m_params.size() * 4);
+	for (size_t i = 0; i < m_params.size(); ++i)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &m_params[i], 4);
+		PutU32(payload.data() + i * 4, bits);
+	}
+
+	bool ok = std::fwrite(header, 1, kHeaderSize, f) == kHeaderSize;
+	ok = ok && std::fwrite(payload.data(), 1, payload.size(), f) == payload.size();
+	return std::fclose(f) == 0 && ok;
+}
+
+bool SnakeMlp::Load(const char* path)
+{
+	FILE* f = std::fopen(path, "rb");
+	if (!f) return false;
+
+	unsigned char header[kHeaderSize];
+	bool ok = std::fread(header, 1, kHeaderSize, f) == kHeaderSize &&
+		std::memcmp(header, kMagic, 4) == 0 && GetU32(header + 4) == kVersion &&
+		GetU32(header + 8) == uint32_t(kInputs) && GetU32(header + 12) == uint32_t(kHidden) &&
+		GetU32(header + 16) == uint32_t(kOutputs) && GetU32(header + 20) == uint32_t(GetParamCount());
+
+	std::vector<unsigned char> payload;
+	if (ok)
+	{
+		payload.resize(size_t(GetParamCount()) * 4);
+		ok = std::fread(payload.data(), 1, payload.size(), f) == payload.size();
+	}
+	std::fclose(f);
+	if (!ok) return false;
+
+	std::vector<float> params(payload.size() / 4);
+	for (size_t i = 0; i < params.size(); ++i)
+	{
+		const uint32_t bits = GetU32(payload.data() + i * 4);
+		std::memcpy(&params[i], &bits, 4);
+	}
+	SetParams(params.data());
+	return true;
+}
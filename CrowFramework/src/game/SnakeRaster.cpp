@@ -0,0 +1,219 @@
+#include <game/SnakeRaster.h>
+#include <game/SnakeBatch.h>
+#include <engine/CpuFeatures.h>
+#include <engine/WorkStealingPool.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(CROW_ARCH_X86)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	// Games per pool task; one image is a few KB
+	const int64_t kGamesPerTask = 8;
+
+	struct RowPlan
+	{
+		const int32_t* srcX;
+		int outW;
+		const int32_t* chunkX;
+		const int32_t* chunkBase;
+		const uint8_t* chunkMask;
+		int chunks;
+		uint8_t lut[2]; // occupancy byte -> gray level
+	};
+
+	void ExpandRowScalar(const uint8_t* row, uint8_t* out, const RowPlan& p)
+	{
+		for (int x = 0; x < p.outW; ++x)
+			out[x] = p.lut[row[p.srcX[x]]];
+	}
+
+#if defined(CROW_ARCH_X86)
+	// Two 16-column chunks per iteration: each 128-bit lane loads the
+	// 16 grid cells its chunk reads, one shuffle picks the source cell
+	// of every output byte and a second one maps 0/1 to gray levels.
+	// Chunks may overlap at the row end, so lanes are stored separately.
+	CROW_TARGET("avx2")
+	void ExpandRowAvx2(const uint8_t* row, uint8_t* out, const RowPlan& p)
+	{
+		const __m128i lut128 = _mm_insert_epi8(_mm_set1_epi8(char(p.lut[0])), p.lut[1], 1);
+		const __m256i lut = _mm256_broadcastsi128_si256(lut128);
+
+		int c = 0;
+		for (; c + 2 <= p.chunks; c += 2)
+		{
+			const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + p.chunkBase[c]));
+			const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + p.chunkBase[c + 1]));
+			const __m256i cells = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+			const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p.chunkMask + size_t(c) * 16));
+			const __m256i gray = _mm256_shuffle_epi8(lut, _mm256_shuffle_epi8(cells, mask));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + p.chunkX[c]), _mm256_castsi256_si128(gray));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + p.chunkX[c + 1]), _mm256_extracti128_si256(gray, 1));
+		}
+
+		if (c < p.chunks)
+		{
+			const __m128i cells = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + p.chunkBase[c]));
+			const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p.chunkMask + size_t(c) * 16));
+			const __m128i gray = _mm_shuffle_epi8(lut128, _mm_shuffle_epi8(cells, mask));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + p.chunkX[c]), gray);
+		}
+	}
+#endif
+}
+
+SnakeRaster::SnakeRaster(int gridW, int gridH, int outW, int outH, const SnakeRasterPalette& palette)
+	: m_gridW(gridW), m_gridH(gridH), m_outW(outW), m_outH(outH), m_palette(palette),
+	m_kernel(SnakeRasterKernel::Scalar), m_useAvx2(false), m_chunksFit(true)
+{
+	// Nearest neighbor: output pixel x samples grid column x * gridW / outW
+	m_srcX.resize(size_t(outW));
+	m_colBegin.assign(size_t(gridW), 0);
+	m_colEnd.assign(size_t(gridW), 0);
+	for (int x = outW - 1; x >= 0; --x)
+	{
+		const int g = int(int64_t(x) * gridW / outW);
+		m_srcX[size_t(x)] = g;
+		if (m_colEnd[size_t(g)] == 0) m_colEnd[size_t(g)] = x + 1;
+		m_colBegin[size_t(g)] = x;
+	}
+
+	m_srcY.resize(size_t(outH));
+	m_rowBegin.assign(size_t(gridH), 0);
+	m_rowEnd.assign(size_t(gridH), 0);
+	for (int y = outH - 1; y >= 0; --y)
+	{
+		const int g = int(int64_t(y) * gridH / outH);
+		m_srcY[size_t(y)] = g;
+		if (m_rowEnd[size_t(g)] == 0) m_rowEnd[size_t(g)] = y + 1;
+		m_rowBegin[size_t(g)] = y;
+	}
+
+	// 16-column chunks; a short last chunk slides back to overlap the
+	// previous one. Loads start at most 16 cells before the row end, so
+	// they never leave the grid row (narrower grids go through a copy).
+	for (int x = 0; x + 16 <= outW; x += 16)
+		m_chunkX.push_back(x);
+	if (outW >= 16 && outW % 16)
+		m_chunkX.push_back(outW - 16);
+
+	for (int x0 : m_chunkX)
+	{
+		const int base = std::min(m_srcX[size_t(x0)], std::max(0, gridW - 16));
+		m_chunkBase.push_back(base);
+		for (int i = 0; i < 16; ++i)
+		{
+			const int offset = m_srcX[size_t(x0 + i)] - base;
+			m_chunksFit = m_chunksFit && offset < 16;
+			m_chunkMask.push_back(uint8_t(offset & 15));
+		}
+	}
+
+	SetKernel(SnakeRasterKernel::Auto);
+}
+
+void SnakeRaster::SetKernel(SnakeRasterKernel kernel)
+{
+	// Downscaling by more than 16:1 makes a chunk outgrow one load
+	const bool avx2Usable = GetCpuFeatures().avx2 && m_chunksFit && !m_chunkX.empty();
+
+	m_kernel = SnakeRasterKernel::Scalar;
+	m_useAvx2 = false;
+
+#if defined(CROW_ARCH_X86)
+	if (kernel != SnakeRasterKernel::Scalar && avx2Usable)
+	{
+		m_kernel = SnakeRasterKernel::Avx2;
+		m_useAvx2 = true;
+	}
+#else
+	(void)kernel;
+	(void)avx2Usable;
+#endif
+}
+
+void SnakeRaster::Render(const SnakeBatch& batch, int game, uint8_t* dst) const
+{
+	RowPlan plan;
+	plan.srcX = m_srcX.data();
+	plan.outW = m_outW;
+	plan.chunkX = m_chunkX.data();
+	plan.chunkBase = m_chunkBase.data();
+	plan.chunkMask = m_chunkMask.data();
+	plan.chunks = int(m_chunkX.size());
+	plan.lut[0] = m_palette.empty;
+	plan.lut[1] = m_palette.body;
+
+	const uint8_t* occupied = batch.GetOccupancy(game);
+	uint8_t narrow[16] = {};
+
+	int lastY = -1;
+	for (int y = 0; y < m_outH; ++y)
+	{
+		uint8_t* out = dst + size_t(y) * size_t(m_outW);
+		const int gy = m_srcY[size_t(y)];
+
+		// Upscaled rows repeat: copy the row above
+		if (gy == lastY)
+		{
+			std::memcpy(out, out - m_outW, size_t(m_outW));
+			continue;
+		}
+		lastY = gy;
+
+		const uint8_t* row = occupied + size_t(gy) * size_t(m_gridW);
+#if defined(CROW_ARCH_X86)
+		if (m_useAvx2)
+		{
+			if (m_gridW < 16)
+			{
+				std::memcpy(narrow, row, size_t(m_gridW));
+				row = narrow;
+			}
+			ExpandRowAvx2(row, out, plan);
+			continue;
+		}
+#endif
+		ExpandRowScalar(row, out, plan);
+	}
+
+	const Cell head = batch.GetHead(game);
+	if (unsigned(head.x) < unsigned(m_gridW) && unsigned(head.y) < unsigned(m_gridH))
+		FillRect(dst, m_colBegin[size_t(head.x)], m_colEnd[size_t(head.x)],
+			m_rowBegin[size_t(head.y)], m_rowEnd[size_t(head.y)], m_palette.head);
+
+	const Cell food = batch.GetFood(game);
+	if (food.x >= 0)
+		FillRect(dst, m_colBegin[size_t(food.x)], m_colEnd[size_t(food.x)],
+			m_rowBegin[size_t(food.y)], m_rowEnd[size_t(food.y)], m_palette.food);
+}
+
+void SnakeRaster::RenderAll(const SnakeBatch& batch, uint8_t* images, WorkStealingPool* pool) const
+{
+	const size_t imageSize = GetImageSize();
+	if (!pool)
+	{
+		for (int i = 0; i < batch.GetCount(); ++i)
+			Render(batch, i, images + size_t(i) * imageSize);
+		return;
+	}
+
+	pool->ParallelFor(0, batch.GetCount(), kGamesPerTask,
+		[this, &batch, images, imageSize](int64_t begin, int64_t end, int)
+		{
+			for (int64_t i = begin; i < end; ++i)
+				Render(batch, int(i), images + size_t(i) * imageSize);
+		});
+}
+
+void SnakeRaster::FillRect(uint8_t* dst, int x0, int x1, int y0, int y1, uint8_t value) const
+{
+	if (x0 >= x1) return;
+	for (int y = y0; y < y1; ++y)
+		std::memset(dst + size_t(y) * size_t(m_outW) + size_t(x0), value, size_t(x1 - x0));
+}
@@ -0,0 +1,226 @@
+#include <game/SnakeReplay.h>
+#include <game/SnakeGame.h>
+
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+	const char kMagic[4] = { 'S', 'N', 'R', 'P' };
+	const uint32_t kVersion = 1;
+
+	void PutU32(unsigned char* p, uint32_t v)
+	{
+		for (int i = 0; i < 4; ++i) p[i] = (unsigned char)(v >> (8 * i));
+	}
+
+	void PutU64(unsigned char* p, uint64_t v)
+	{
+		for (int i = 0; i < 8; ++i) p[i] = (unsigned char)(v >> (8 * i));
+	}
+
+	uint32_t GetU32(const unsigned char* p)
+	{
+		uint32_t v = 0;
+		for (int i = 0; i < 4; ++i) v |= uint32_t(p[i]) << (8 * i);
+		return v;
+	}
+
+	uint64_t GetU64(const unsigned char* p)
+	{
+		uint64_t v = 0;
+		for (int i = 0; i < 8; ++i) v |= uint64_t(p[i]) << (8 * i);
+		return v;
+	}
+
+	// magic, version, gridW, gridH, seed, steps
+	const size_t kHeaderSize = 4 + 4 + 4 + 4 + 8 + 8;
+
+	// Play `total` logged steps on a freshly reset game; word(w) returns
+	// the 2-bit directions of steps [32w, 32w + 32)
+	template <typename WordFn>
+	SnakeReplayResult Simulate(SnakeGame& game, uint64_t total, WordFn word)
+	{
+		// Unpack a word at a time; logged directions are never reversals,
+		// since SetPendingDir would silently drop them
+		const size_t words = size_t((total + 31) / 32);
+		bool valid = true;
+		uint64_t step = 0;
+
+		for (size_t w = 0; w < words && valid; ++w)
+		{
+			uint64_t bits = word(w);
+			const uint64_t end = total - step < 32 ? total : step + 32;
+			for (; step < end; ++step, bits >>= 2)
+			{
+				const Dir d = Dir(bits & 3);
+				if (game.IsGameOver() || (int(d) ^ int(game.GetDir())) == 1)
+				{
+					valid = false;
+					break;
+				}
+				game.SetPendingDir(d);
+				game.Tick();
+			}
+		}
+
+		SnakeReplayResult result;
+		result.valid = valid;
+		result.steps = step;
+		result.score = game.GetScore();
+		result.length = game.GetLength();
+		result.gameOver = game.IsGameOver();
+		result.won = game.IsWon();
+		result.deathCause = game.GetDeathCause();
+		return result;
+	}
+}
+
+void SnakeReplay::Begin(int gridW, int gridH, uint64_t seed)
+{
+	m_gridW = gridW;
+	m_gridH = gridH;
+	m_seed = seed;
+	m_steps = 0;
+	m_words.clear(); // keeps capacity across games
+}
+
+bool SnakeReplay::Save(const char* path) const
+{
+	FILE* f = std::fopen(path, "wb");
+	if (!f) return false;
+
+	unsigned char header[kHeaderSize];
+	std::memcpy(header, kMagic, 4);
+	PutU32(header + 4, kVersion);
+	PutU32(header + 8, uint32_t(m_gridW));
+	PutU32(header + 12, uint32_t(m_gridH));
+	PutU64(header + 16, m_seed);
+	PutU64(header + 24, m_steps);
+
+	// Words are written byte by byte so the file is the same on any host
+	std::vector<unsigned char> payload(GetPackedSize());
+	for (size_t i = 0; i < payload.size(); ++i)
+		payload[i] = (unsigned char)(m_words[i >> 3] >> ((i & 7) * 8));
+
+	bool ok = std::fwrite(header, 1, kHeaderSize, f) == kHeaderSize;
+	ok = ok && std::fwrite(payload.data(), 1, payload.size(), f) == payload.size();
+	return std::fclose(f) == 0 && ok;
+}
+
+bool SnakeReplay::Load(const char* path)
+{
+	FILE* f = std::fopen(path, "rb");
+	if (!f) return false;
+
+	unsigned char header[kHeaderSize];
+	bool ok = std::fread(header, 1, kHeaderSize, f) == kHeaderSize &&
+		std::memcmp(header, kMagic, 4) == 0 && GetU32(header + 4) == kVersion;
+
+	const int gridW = int(GetU32(header + 8));
+	const int gridH = int(GetU32(header + 12));
+	const uint64_t steps = GetU64(header + 24);
+	ok = ok && IsPlayableGrid(gridW, gridH) && steps < (uint64_t(1) << 40);
+
+	std::vector<unsigned char> payload;
+	if (ok)
+	{
+		payload.resize(size_t((steps + 3) / 4));
+		ok = std::fread(payload.data(), 1, payload.size(), f) == payload.size();
+	}
+	std::fclose(f);
+	if (!ok) return false;
+
+	Begin(gridW, gridH, GetU64(header + 16));
+	m_steps = steps;
+	m_words.assign(size_t((steps + 31) / 32), 0);
+	for (size_t i = 0; i < payload.size(); ++i)
+		m_words[i >> 3] |= uint64_t(payload[i]) << ((i & 7) * 8);
+
+	// Bits past the last step must read as zero for Append to continue
+	if (m_steps & 31)
+		m_words.back() &= (uint64_t(1) << ((m_steps & 31) * 2)) - 1;
+	return true;
+}
+
+SnakeReplayResult SimulateReplay(const SnakeReplay& replay, std::shared_ptr<const LevelMap> level)
+{
+	SnakeReplayResult result;
+	if (!IsPlayableGrid(replay.GetGridW(), replay.GetGridH()))
+		return result;
+
+	SnakeGame game(replay.GetGridW(), replay.GetGridH(), replay.GetSeed());
+	if (!game.SetLevel(std::move(level)))
+		return result;
+	const std::vector<uint64_t>& words = replay.GetWords();
+	return Simulate(game, replay.GetStepCount(), [&words](size_t w) { return words[w]; });
+}
+
+SnakeReplayResult SimulatePackedReplay(SnakeGame& game, uint64_t seed, const uint8_t* packed, uint64_t steps)
+{
+	game.Reset(seed);
+
+	// Word w = bytes [8w, 8w + 8) of the little-endian payload, cut at its end
+	const size_t bytes = size_t((steps + 3) / 4);
+	return Simulate(game, steps, [packed, bytes](size_t w)
+		{
+			const size_t begin = w * 8;
+			const size_t end = bytes - begin < 8 ? bytes : begin + 8;
+			uint64_t v = 0;
+			for (size_t i = begin; i < end; ++i)
+				v |= uint64_t(packed[i]) << ((i - begin) * 8);
+			return v;
+		});
+}
+
+SnakeReplayPlayer::SnakeReplayPlayer() = default;
+SnakeReplayPlayer::~SnakeReplayPlayer() = default;
+
+void SnakeReplayPlayer::Start(const SnakeReplay& replay, std::shared_ptr<const LevelMap> level)
+{
+	Stop();
+	if (!IsPlayableGrid(replay.GetGridW(), replay.GetGridH()))
+		return;
+
+	auto game = std::make_unique<SnakeGame>(replay.GetGridW(), replay.GetGridH(), replay.GetSeed());
+	if (!game->SetLevel(std::move(level)))
+		return;
+
+	m_replay = &replay;
+	m_game = std::move(game);
+}
+
+void SnakeReplayPlayer::Stop()
+{
+	m_replay = nullptr;
+	m_game.reset();
+	m_step = 0;
+	m_acc = 0.0f;
+}
+
+void SnakeReplayPlayer::Update(float dt, float speed)
+{
+	if (!m_replay) return;
+
+	// Same fixed step as live play, scaled
+	m_acc += dt * speed;
+	const float stepTime = m_game->GetStepTime();
+	while (m_acc >= stepTime && !IsFinished())
+	{
+		Advance();
+		m_acc -= stepTime;
+	}
+	if (IsFinished()) m_acc = 0.0f;
+}
+
+bool SnakeReplayPlayer::IsFinished() const
+{
+	return !m_replay || m_step >= m_replay->GetStepCount() || m_game->IsGameOver();
+}
+
+void SnakeReplayPlayer::Advance()
+{
+	m_game->SetPendingDir(m_replay->GetDir(m_step++));
+	m_game->Tick();
+}
@@ -0,0 +1,114 @@
+#include <game/SnakeRunner.h>
+#include <engine/WorkStealingPool.h>
+#include <game/LevelMap.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+void RunnerStats::Add(const SnakeGame& game, EpisodeEnd end, uint64_t episodeSteps)
+{
+	const int score = game.GetScore();
+	scoreMin = episodes ? std::min(scoreMin, score) : score;
+	scoreMax = episodes ? std::max(scoreMax, score) : score;
+
+	episodes++;
+	steps += episodeSteps;
+	scoreSum += score;
+	lengthSum += game.GetLength();
+	ends[int(end)]++;
+}
+
+void RunnerStats::Merge(const RunnerStats& other)
+{
+	if (!other.episodes) return;
+
+	scoreMin = episodes ? std::min(scoreMin, other.scoreMin) : other.scoreMin;
+	scoreMax = episodes ? std::max(scoreMax, other.scoreMax) : other.scoreMax;
+
+	episodes += other.episodes;
+	steps += other.steps;
+	scoreSum += other.scoreSum;
+	lengthSum += other.lengthSum;
+	for (int i = 0; i < int(EpisodeEnd::Count); ++i)
+		ends[i] += other.ends[i];
+}
+
+EpisodeEnd RunEpisode(SnakeGame& game, uint64_t seed, const SnakePolicy& policy, int worker,
+	int starveSteps, uint64_t& steps)
+{
+	// Stream 0 feeds the food, stream 1 the policy
+	game.Reset(seed);
+	SnakeRng rng = SnakeRng::ForStream(seed, 1);
+	steps = 0;
+
+	int lastLength = game.GetLength();
+	int hungry = 0;
+
+	while (!game.IsGameOver())
+	{
+		game.SetPendingDir(policy(game, rng, worker));
+		game.Tick();
+		steps++;
+
+		// Policies that circle forever would never finish the episode
+		if (game.GetLength() != lastLength)
+		{
+			lastLength = game.GetLength();
+			hungry = 0;
+		}
+		else if (++hungry >= starveSteps)
+			return EpisodeEnd::Starved;
+	}
+
+	if (game.IsWon()) return EpisodeEnd::Won;
+	return game.GetDeathCause() == DeathCause::Wall ? EpisodeEnd::Wall : EpisodeEnd::Self;
+}
+
+RunnerStats RunEpisodes(WorkStealingPool& pool, const RunnerConfig& config, const SnakePolicy& policy)
+{
+	const int workers = pool.GetThreadCount();
+	const int starveSteps = config.starveSteps > 0 ? config.starveSteps : config.gridW * config.gridH;
+
+	// A level of another size would leave every game on the open board
+	if (config.level && (config.level->GetGridW() != config.gridW || config.level->GetGridH() != config.gridH))
+		return RunnerStats();
+
+	// Per-thread accumulator and game, cache-line separated, merged at the end
+	struct alignas(64) WorkerState
+	{
+		RunnerStats stats;
+		std::unique_ptr<SnakeGame> game;
+	};
+	std::vector<WorkerState> state(static_cast<size_t>(workers));
+	for (WorkerState& s : state)
+	{
+		s.game = std::make_unique<SnakeGame>(config.gridW, config.gridH);
+		const bool levelSet = s.game->SetLevel(config.level);
+		assert(levelSet);
+		(void)levelSet;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	pool.ParallelFor(int64_t(config.seedBegin), int64_t(config.seedEnd), config.grain,
+		[&](int64_t begin, int64_t end, int worker)
+		{
+			WorkerState& s = state[worker];
+			for (int64_t seed = begin; seed < end; ++seed)
+			{
+				uint64_t steps = 0;
+				EpisodeEnd how = RunEpisode(*s.game, uint64_t(seed), policy, worker, starveSteps, steps);
+				s.stats.Add(*s.game, how, steps);
+			}
+		});
+
+	RunnerStats total;
+	for (const WorkerState& s : state)
+		total.Merge(s.stats);
+
+	total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return total;
+}
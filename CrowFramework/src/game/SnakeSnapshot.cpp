@@ -0,0 +1,31 @@
+#include <game/SnakeSnapshot.h>
+#include <game/SnakeGame.h>
+
+#include <cassert>
+
+SnakeSnapshotArena::SnakeSnapshotArena(const SnakeGame& game, int maxDepth)
+	: m_slotSize(game.GetSnapshotSize()), m_maxDepth(maxDepth), m_depth(0)
+{
+	// The only allocation: every slot up front
+	m_storage.resize(m_slotSize / sizeof(uint64_t) * size_t(maxDepth));
+	m_base = reinterpret_cast<unsigned char*>(m_storage.data());
+}
+
+bool SnakeSnapshotArena::Push(const SnakeGame& game)
+{
+	if (m_depth == m_maxDepth) return false;
+	game.Save(Slot(m_depth++));
+	return true;
+}
+
+void SnakeSnapshotArena::Pop(SnakeGame& game)
+{
+	assert(m_depth > 0);
+	game.Restore(Slot(--m_depth));
+}
+
+void SnakeSnapshotArena::RestoreTop(SnakeGame& game) const
+{
+	assert(m_depth > 0);
+	game.Restore(Slot(m_depth - 1));
+}
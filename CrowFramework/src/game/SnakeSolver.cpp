@@ -0,0 +1,165 @@
+#include <game/SnakeSolver.h>
+#include <game/SnakeGame.h>
+#include <game/SnakeSnapshot.h>
+#include <engine/WorkStealingPool.h>
+
+#include <chrono>
+#include <cstdlib>
+
+namespace
+{
+	// Snapshot stack depth per task; deeper subtrees go back to the pool
+	const int kStackDepth = 256;
+
+	// Keep about this many spawned tasks waiting per thread
+	const int kQueuedPerThread = 4;
+}
+
+SnakeSolver::SnakeSolver(WorkStealingPool& pool, int memoLog2)
+	: m_pool(pool), m_memo(memoLog2),
+	m_best(0), m_queued(0), m_stop(false), m_full(false), m_maxPossible(0)
+{
+}
+
+SnakeSolver::~SnakeSolver() = default;
+
+SolveResult SnakeSolver::Solve(const SnakeGame& start)
+{
+	auto begin = std::chrono::steady_clock::now();
+
+	m_memo.Clear();
+	m_workers.clear();
+	for (int i = 0; i < m_pool.GetThreadCount(); ++i)
+	{
+		auto w = std::make_unique<Worker>();
+		w->game = std::make_unique<SnakeGame>(start.GetGridW(), start.GetGridH());
+		w->game->SetLevel(start.GetLevel());
+		w->stack = std::make_unique<SnakeSnapshotArena>(start, kStackDepth);
+		m_workers.push_back(std::move(w));
+	}
+
+	m_maxPossible = start.GetGridW() * start.GetGridH() - 3;
+	m_best.store(start.GetScore());
+	m_queued.store(0);
+	m_stop.store(false);
+	m_full.store(false);
+
+	if (!start.IsGameOver())
+	{
+		m_memo.Add(start.ComputeStateHash());
+		Spawn(start);
+		m_pool.Wait();
+	}
+	else if (start.IsWon())
+		Record(m_maxPossible);
+
+	SolveResult result;
+	result.maxScore = m_best.load();
+	result.maxPossible = m_maxPossible;
+	result.proven = !m_full.load() || result.maxScore == m_maxPossible;
+	result.states = 1;
+	for (const auto& w : m_workers)
+		result.states += w->states;
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	return result;
+}
+
+void SnakeSolver::Spawn(const SnakeGame& game)
+{
+	auto slot = std::make_shared<std::vector<uint64_t>>((game.GetSnapshotSize() + 7) / 8);
+	game.Save(slot->data());
+
+	m_queued.fetch_add(1, std::memory_order_relaxed);
+	m_pool.Submit([this, slot](int worker)
+		{
+			m_queued.fetch_sub(1, std::memory_order_relaxed);
+			if (m_stop.load(std::memory_order_relaxed)) return;
+
+			Worker& w = *m_workers[size_t(worker)];
+			w.game->Restore(slot->data());
+			Expand(w);
+		});
+}
+
+void SnakeSolver::Expand(Worker& w)
+{
+	if (m_stop.load(std::memory_order_relaxed)) return;
+
+	SnakeGame& game = *w.game;
+	SnakeSnapshotArena& stack = *w.stack;
+	if (!stack.Push(game))
+	{
+		Spawn(game);
+		return;
+	}
+
+	// Moves toward the food first: long games (and a filled board, which
+	// ends the search) turn up early. Reversing is ignored by the game,
+	// the same as going straight, so it is left out.
+	const Cell head = game.GetHead();
+	const Cell food = game.GetFood();
+	const int current = int(game.GetDir());
+	int order[3], distance[3], count = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		if ((i ^ current) == 1) continue;
+
+		const Cell next = Neighbor(head, Dir(i));
+		const int d = std::abs(next.x - food.x) + std::abs(next.y - food.y);
+		int k = count++;
+		for (; k > 0 && distance[k - 1] > d; --k)
+		{
+			order[k] = order[k - 1];
+			distance[k] = distance[k - 1];
+		}
+		order[k] = i;
+		distance[k] = d;
+	}
+
+	const int spawnBelow = m_pool.GetThreadCount() * kQueuedPerThread;
+	for (int k = 0; k < count; ++k)
+	{
+		const int i = order[k];
+		stack.RestoreTop(game);
+		game.SetPendingDir(Dir(i));
+		game.Tick();
+
+		if (game.IsGameOver())
+		{
+			if (game.IsWon()) Record(m_maxPossible);
+			continue;
+		}
+
+		const ConcurrentHashSet::AddResult added = m_memo.Add(game.ComputeStateHash());
+		if (added == ConcurrentHashSet::AddResult::Present) continue;
+		if (added == ConcurrentHashSet::AddResult::Full)
+		{
+			m_full.store(true, std::memory_order_relaxed);
+			m_stop.store(true, std::memory_order_relaxed);
+			break;
+		}
+
+		w.states++;
+		Record(game.GetScore());
+
+		if (m_queued.load(std::memory_order_relaxed) < spawnBelow)
+			Spawn(game);
+		else
+			Expand(w);
+
+		if (m_stop.load(std::memory_order_relaxed)) break;
+	}
+
+	stack.Drop();
+}
+
+void SnakeSolver::Record(int score)
+{
+	int best = m_best.load(std::memory_order_relaxed);
+	while (score > best && !m_best.compare_exchange_weak(best, score, std::memory_order_relaxed))
+	{
+	}
+
+	if (score >= m_maxPossible)
+		m_stop.store(true, std::memory_order_relaxed);
+}
@@ -0,0 +1,172 @@
+#include <game/SnakeVecEnv.h>
+#include <engine/WorkStealingPool.h>
+
+#include <algorithm>
+#include <cstring>
+
+SnakeVecEnv::SnakeVecEnv(int envs, int gridW, int gridH, int threads, int starveSteps)
+	: m_envs(envs), m_gridW(gridW), m_gridH(gridH), m_cells(gridW * gridH),
+	m_starveSteps(starveSteps > 0 ? starveSteps : gridW * gridH * 4),
+	m_seed(size_t(envs), 0), m_hungry(size_t(envs), 0),
+	m_obs(nullptr), m_rewards(nullptr), m_dones(nullptr), m_finalScores(nullptr)
+{
+	const int shards = std::max(1, std::min(threads, envs));
+	if (shards > 1)
+		m_pool = std::make_unique<WorkStealingPool>(shards);
+
+	m_shards.resize(size_t(shards));
+	for (int s = 0; s < shards; ++s)
+	{
+		Shard& shard = m_shards[size_t(s)];
+		shard.begin = int(int64_t(envs) * s / shards);
+		shard.count = int(int64_t(envs) * (s + 1) / shards) - shard.begin;
+		shard.batch = std::make_unique<SnakeBatch>(shard.count, gridW, gridH);
+		shard.actions.resize(size_t(shard.count));
+		shard.head.resize(size_t(shard.count));
+		shard.tail.resize(size_t(shard.count));
+		shard.food.resize(size_t(shard.count));
+		shard.length.resize(size_t(shard.count));
+	}
+}
+
+SnakeVecEnv::~SnakeVecEnv() = default;
+
+void SnakeVecEnv::SetBuffers(uint8_t* obs, float* rewards, uint8_t* dones, int32_t* finalScores)
+{
+	m_obs = obs;
+	m_rewards = rewards;
+	m_dones = dones;
+	m_finalScores = finalScores;
+}
+
+void SnakeVecEnv::Reset(const uint64_t* seeds)
+{
+	for (Shard& shard : m_shards)
+		for (int i = 0; i < shard.count; ++i)
+		{
+			const int env = shard.begin + i;
+			ResetEnv(shard, i, seeds[env]);
+			m_rewards[env] = 0.0f;
+			m_dones[env] = Running;
+			if (m_finalScores) m_finalScores[env] = -1;
+		}
+}
+
+void SnakeVecEnv::Step(const uint8_t* actions)
+{
+	if (!m_pool)
+	{
+		StepShard(m_shards[0], actions);
+		return;
+	}
+
+	m_pool->ParallelFor(0, int64_t(m_shards.size()), 1,
+		[this, actions](int64_t begin, int64_t end, int)
+		{
+			for (int64_t s = begin; s < end; ++s)
+				StepShard(m_shards[size_t(s)], actions);
+		});
+}
+
+void SnakeVecEnv::StepShard(Shard& shard, const uint8_t* actions)
+{
+	SnakeBatch& batch = *shard.batch;
+	const int begin = shard.begin;
+	const int gridW = m_gridW;
+
+	for (int i = 0; i < shard.count; ++i)
+	{
+		shard.actions[size_t(i)] = Dir(actions[begin + i] & 3);
+
+		const Cell head = batch.GetHead(i);
+		const Cell food = batch.GetFood(i);
+		shard.head[size_t(i)] = head.y * gridW + head.x;
+		shard.tail[size_t(i)] = TailCell(batch, i, gridW);
+		shard.food[size_t(i)] = food.x >= 0 ? food.y * gridW + food.x : -1;
+		shard.length[size_t(i)] = batch.GetLength(i);
+	}
+
+	uint8_t* dones = m_dones + begin;
+	batch.Step(shard.actions.data(), dones, m_rewards + begin);
+
+	for (int i = 0; i < shard.count; ++i)
+	{
+		const int env = begin + i;
+		const int length = batch.GetLength(i);
+		if (m_finalScores) m_finalScores[env] = -1;
+
+		if (!dones[i])
+		{
+			if (length != shard.length[size_t(i)])
+				m_hungry[size_t(env)] = 0;
+			else if (++m_hungry[size_t(env)] >= m_starveSteps)
+				dones[i] = Truncated;
+		}
+
+		if (dones[i])
+		{
+			if (m_finalScores) m_finalScores[env] = batch.GetScore(i);
+			ResetEnv(shard, i, m_seed[size_t(env)] + uint64_t(m_envs));
+			continue;
+		}
+
+		// Old head turns into body, the new head appears; the tail cell
+		// empties unless the snake grew, in which case the food moved
+		uint8_t* obs = m_obs + size_t(env) * GetObsSize();
+		uint8_t* body = obs + size_t(PlaneBody) * size_t(m_cells);
+		uint8_t* heads = obs + size_t(PlaneHead) * size_t(m_cells);
+		uint8_t* foods = obs + size_t(PlaneFood) * size_t(m_cells);
+
+		const Cell head = batch.GetHead(i);
+		heads[shard.head[size_t(i)]] = 0;
+		body[shard.head[size_t(i)]] = 1;
+		heads[head.y * gridW + head.x] = 1;
+
+		if (length == shard.length[size_t(i)])
+			body[shard.tail[size_t(i)]] = 0;
+		else
+		{
+			const Cell food = batch.GetFood(i);
+			if (shard.food[size_t(i)] >= 0) foods[shard.food[size_t(i)]] = 0;
+			if (food.x >= 0) foods[food.y * gridW + food.x] = 1;
+		}
+	}
+}
+
+void SnakeVecEnv::ResetEnv(Shard& shard, int local, uint64_t seed)
+{
+	const int env = shard.begin + local;
+	m_seed[size_t(env)] = seed;
+	m_hungry[size_t(env)] = 0;
+	shard.batch->Reset(local, seed);
+	WriteObs(shard, local);
+}
+
+void SnakeVecEnv::WriteObs(const Shard& shard, int local)
+{
+	const SnakeBatch& batch = *shard.batch;
+	uint8_t* obs = m_obs + size_t(shard.begin + local) * GetObsSize();
+	std::memset(obs, 0, GetObsSize());
+
+	uint8_t* body = obs + size_t(PlaneBody) * size_t(m_cells);
+	uint8_t* heads = obs + size_t(PlaneHead) * size_t(m_cells);
+	uint8_t* foods = obs + size_t(PlaneFood) * size_t(m_cells);
+
+	bool first = true;
+	batch.GetBody(local).ForEach([&](const Cell& c)
+		{
+			(first ? heads : body)[c.y * m_gridW + c.x] = 1;
+			first = false;
+		});
+
+	const Cell food = batch.GetFood(local);
+	if (food.x >= 0) foods[food.y * m_gridW + food.x] = 1;
+}
+
+int SnakeVecEnv::TailCell(const SnakeBatch& batch, int game, int gridW)
+{
+	const BodySpans body = batch.GetBody(game);
+	const CellSpan& last = body.second.size ? body.second : body.first;
+	const Cell& tail = last.data[last.size - 1];
+	return tail.y * gridW + tail.x;
+}
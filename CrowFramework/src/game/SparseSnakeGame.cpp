@@ -0,0 +1,367 @@
+#include <game/SparseSnakeGame.h>
+#include <engine/BitOps.h>
+
+#include <cassert>
+
+namespace
+{
+	// Random draws before food placement falls back to the exact pick
+	const int kMaxDraws = 64;
+
+	// Emptied tiles kept for reuse, so a snake weaving along a tile
+	// border does not allocate on every crossing
+	const size_t kSpareTiles = 16;
+
+	const int kInitialBody = 64;
+}
+
+SparseSnakeGame::SparseSnakeGame(int gridW, int gridH, uint64_t seed)
+	: m_gridW(gridW), m_gridH(gridH),
+	m_tilesX((gridW + kTileSize - 1) >> kTileShift),
+	m_tilesY((gridH + kTileSize - 1) >> kTileShift),
+	m_cells(uint64_t(gridW) * uint64_t(gridH)),
+	m_directory(size_t(m_tilesX) * size_t(m_tilesY), 0),
+	m_liveTiles(0),
+	m_dir(Dir::Right), m_pendingDir(Dir::Right),
+	m_gameOver(false), m_won(false), m_deathCause(DeathCause::None),
+	m_stepTime(0.2f), m_acc(0.0f),
+	m_seed(seed)
+{
+	// Reset() puts the tail at gridW / 2 - 2
+	assert(gridW >= 4 && gridH >= 1 && gridW <= kMaxSide && gridH <= kMaxSide);
+
+	m_snake.Init(kInitialBody);
+	Reset();
+}
+
+SparseSnakeGame::~SparseSnakeGame() = default;
+
+void SparseSnakeGame::Reset()
+{
+	// Releasing the old body empties exactly the tiles it used
+	while (m_snake.Size() > 0)
+	{
+		Release(m_snake.Back());
+		m_snake.PopBack();
+	}
+
+	m_rng.Seed(m_seed);
+	m_gameOver = false;
+	m_won = false;
+	m_deathCause = DeathCause::None;
+	m_acc = 0.0f;
+
+	m_dir = Dir::Right;
+	m_pendingDir = Dir::Right;
+	m_food = { -1, -1 };
+
+	int cx = m_gridW / 2;
+	int cy = m_gridH / 2;
+
+	// front = head, so push tail first
+	const Cell start[] = { { cx - 2, cy }, { cx - 1, cy }, { cx, cy } };
+	for (const Cell& part : start)
+	{
+		PushFront(part);
+		Occupy(part);
+	}
+
+	SpawnFood();
+}
+
+void SparseSnakeGame::Reset(uint64_t seed)
+{
+	m_seed = seed;
+	Reset();
+}
+
+void SparseSnakeGame::Update(float dt)
+{
+	if (m_gameOver) return;
+
+	m_acc += dt;
+
+	while (m_acc >= m_stepTime)
+	{
+		Step();
+		m_acc -= m_stepTime;
+	}
+}
+
+void SparseSnakeGame::Tick()
+{
+	if (m_gameOver) return;
+	Step();
+}
+
+void SparseSnakeGame::SetPendingDir(Dir dir)
+{
+	if (!IsOpposite(m_dir, dir))
+		m_pendingDir = dir;
+}
+
+bool SparseSnakeGame::IsGameOver() const
+{
+	return m_gameOver;
+}
+
+bool SparseSnakeGame::IsWon() const
+{
+	return m_won;
+}
+
+DeathCause SparseSnakeGame::GetDeathCause() const
+{
+	return m_deathCause;
+}
+
+const Cell& SparseSnakeGame::GetHead() const
+{
+	return m_snake.Front();
+}
+
+const Cell& SparseSnakeGame::GetTail() const
+{
+	return m_snake.Back();
+}
+
+BodySpans SparseSnakeGame::GetBody() const
+{
+	return m_snake.Spans();
+}
+
+int SparseSnakeGame::GetLength() const
+{
+	return m_snake.Size();
+}
+
+const Cell& SparseSnakeGame::GetFood() const
+{
+	return m_food;
+}
+
+Dir SparseSnakeGame::GetDir() const
+{
+	return m_dir;
+}
+
+bool SparseSnakeGame::IsBlocked(const Cell& c) const
+{
+	return HitsWall(c) || HitsSelf(c);
+}
+
+int SparseSnakeGame::GetGridW() const
+{
+	return m_gridW;
+}
+
+int SparseSnakeGame::GetGridH() const
+{
+	return m_gridH;
+}
+
+int SparseSnakeGame::GetScore() const
+{
+	return m_snake.Size() - 3;
+}
+
+uint64_t SparseSnakeGame::GetSeed() const
+{
+	return m_seed;
+}
+
+float SparseSnakeGame::GetStepTime() const
+{
+	return m_stepTime;
+}
+
+size_t SparseSnakeGame::GetMemoryBytes() const
+{
+	return m_directory.capacity() * sizeof(uint32_t) +
+		m_tiles.capacity() * sizeof(m_tiles[0]) + m_freeSlots.capacity() * sizeof(uint32_t) +
+		(size_t(m_liveTiles) + m_spare.size()) * sizeof(Tile) +
+		size_t(m_snake.Capacity()) * sizeof(Cell);
+}
+
+void SparseSnakeGame::Step()
+{
+	m_dir = m_pendingDir;
+
+	Cell newHead = NextHead();
+
+	// Death check before mutating body
+	if (HitsWall(newHead) || HitsSelf(newHead))
+	{
+		m_gameOver = true;
+		m_deathCause = HitsWall(newHead) ? DeathCause::Wall : DeathCause::Self;
+		return;
+	}
+
+	PushFront(newHead);
+	Occupy(newHead);
+
+	if (EatsFood(newHead))
+		SpawnFood();
+	else
+	{
+		Release(m_snake.Back());
+		m_snake.PopBack();
+	}
+}
+
+Cell SparseSnakeGame::NextHead() const
+{
+	return Neighbor(m_snake.Front(), m_dir);
+}
+
+bool SparseSnakeGame::IsOpposite(Dir a, Dir b) const
+{
+	return (a == Dir::Up && b == Dir::Down) ||
+		(a == Dir::Down && b == Dir::Up) ||
+		(a == Dir::Left && b == Dir::Right) ||
+		(a == Dir::Right && b == Dir::Left);
+}
+
+bool SparseSnakeGame::HitsWall(const Cell& c) const
+{
+	return unsigned(c.x) >= unsigned(m_gridW) || unsigned(c.y) >= unsigned(m_gridH);
+}
+
+bool SparseSnakeGame::HitsSelf(const Cell& c) const
+{
+	// No tile = nothing of the snake in this 64x64 block
+	const uint32_t slot = m_directory[TileIndex(c)];
+	if (!slot) return false;
+
+	const Tile& tile = *m_tiles[slot - 1];
+	return (tile.rows[c.y & (kTileSize - 1)] >> (c.x & (kTileSize - 1))) & 1;
+}
+
+bool SparseSnakeGame::EatsFood(const Cell& c) const
+{
+	return c.x == m_food.x && c.y == m_food.y;
+}
+
+void SparseSnakeGame::SpawnFood()
+{
+	const uint64_t freeCount = m_cells - uint64_t(m_snake.Size());
+	if (freeCount == 0)
+	{
+		m_gameOver = true;
+		m_won = true;
+		m_food = { -1, -1 };
+		return;
+	}
+
+	// Uniform cell, redrawn while it lands on the snake: expected O(1)
+	// draws while the snake covers a minority of the board
+	for (int i = 0; i < kMaxDraws; ++i)
+	{
+		const Cell c = { int(m_rng.NextBelow(uint32_t(m_gridW))), int(m_rng.NextBelow(uint32_t(m_gridH))) };
+		if (!HitsSelf(c))
+		{
+			m_food = c;
+			return;
+		}
+	}
+
+	// Crowded board: k-th free cell through the tile counts, O(tiles)
+	PickFreeCell(m_rng.Next() % freeCount, m_food);
+}
+
+bool SparseSnakeGame::PickFreeCell(uint64_t k, Cell& out) const
+{
+	for (int ty = 0; ty < m_tilesY; ++ty)
+	{
+		const int y0 = ty << kTileShift;
+		const int rows = m_gridH - y0 < kTileSize ? m_gridH - y0 : kTileSize;
+
+		for (int tx = 0; tx < m_tilesX; ++tx)
+		{
+			const int x0 = tx << kTileShift;
+			const int cols = m_gridW - x0 < kTileSize ? m_gridW - x0 : kTileSize;
+			const uint32_t slot = m_directory[size_t(ty) * size_t(m_tilesX) + size_t(tx)];
+			const Tile* tile = slot ? m_tiles[slot - 1].get() : nullptr;
+
+			const uint64_t free = uint64_t(rows) * uint64_t(cols) - uint64_t(tile ? tile->count : 0);
+			if (k >= free)
+			{
+				k -= free;
+				continue;
+			}
+
+			const uint64_t colMask = cols == 64 ? ~uint64_t(0) : (uint64_t(1) << cols) - 1;
+			for (int r = 0; r < rows; ++r)
+			{
+				const uint64_t empty = ~(tile ? tile->rows[r] : 0) & colMask;
+				const int n = PopCount64(empty);
+				if (k < uint64_t(n))
+				{
+					out = { x0 + SelectBit64(empty, int(k)), y0 + r };
+					return true;
+				}
+				k -= uint64_t(n);
+			}
+		}
+	}
+	return false;
+}
+
+void SparseSnakeGame::PushFront(const Cell& c)
+{
+	// Grow the ring by doubling: amortized O(1) per segment
+	if (m_snake.Size() == m_snake.Capacity())
+		m_snake.Grow();
+	m_snake.PushFront(c);
+}
+
+void SparseSnakeGame::Occupy(const Cell& c)
+{
+	uint32_t& slot = m_directory[TileIndex(c)];
+	if (!slot)
+	{
+		std::unique_ptr<Tile> tile;
+		if (!m_spare.empty())
+		{
+			tile = std::move(m_spare.back());
+			m_spare.pop_back();
+		}
+		else
+			tile = std::make_unique<Tile>();
+		*tile = Tile();
+
+		if (m_freeSlots.empty())
+		{
+			m_tiles.push_back(std::move(tile));
+			slot = uint32_t(m_tiles.size());
+		}
+		else
+		{
+			slot = m_freeSlots.back() + 1;
+			m_freeSlots.pop_back();
+			m_tiles[slot - 1] = std::move(tile);
+		}
+		m_liveTiles++;
+	}
+
+	Tile& tile = *m_tiles[slot - 1];
+	tile.rows[c.y & (kTileSize - 1)] |= uint64_t(1) << (c.x & (kTileSize - 1));
+	tile.count++;
+}
+
+void SparseSnakeGame::Release(const Cell& c)
+{
+	uint32_t& slot = m_directory[TileIndex(c)];
+	std::unique_ptr<Tile>& tile = m_tiles[slot - 1];
+	tile->rows[c.y & (kTileSize - 1)] &= ~(uint64_t(1) << (c.x & (kTileSize - 1)));
+	if (--tile->count > 0) return;
+
+	// Last segment left: the tile goes back to the spare list or is freed
+	if (m_spare.size() < kSpareTiles)
+		m_spare.push_back(std::move(tile));
+	else
+		tile.reset();
+	m_freeSlots.push_back(slot - 1);
+	slot = 0;
+	m_liveTiles--;
+}
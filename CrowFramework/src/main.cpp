@@ -2,10 +2,13 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <iostream>
+#include <future>
+#include <memory>
 
 #include <gl2d/gl2d.h>
 #include <engine/debug/openglErrorReporting.h>
 #include <engine/Shader.h>
+#include <engine/InstanceRing.h>
 
 #include "imgui.h"
 #include "backends/imgui_impl_glfw.h"
@@ -13,6 +16,15 @@
 #include "imguiThemes.h"
 
 #include <game/SnakeGame.h>
+#include <game/SnakeReplay.h>
+#include <game/SnakeArchive.h>
+#include <game/LevelMap.h>
+#include <game/SnakeAutopilot.h>
+#include <game/HamiltonianSolver.h>
+#include <game/SnakeMcts.h>
+#include <game/SnakeMlp.h>
+#include <engine/WorkStealingPool.h>
+#include <tools/HeadlessTools.h>
 
 #pragma region CrowFramework_Config
 /// ============================================================================
@@ -59,8 +71,19 @@ static float rect[] = {
 #pragma endregion
 
 #pragma region Main
-int main()
+int main(int argc, char** argv)
 {
+#pragma region Headless_Tools
+	/// ========================================================================
+	/// Headless Tools
+	/// ------------------------------------------------------------------------
+	/// - "CrowFramework <command> ..." runs a benchmark / batch job and exits.
+	/// - No window or GL context is created for these.
+	/// ========================================================================
+	int toolResult = RunHeadlessCommand(argc, argv);
+	if (toolResult >= 0) return toolResult;
+#pragma endregion
+
 #pragma region Engine_Startup
 	/// ========================================================================
 	/// Engine Startup
@@ -127,7 +150,8 @@ int main()
 	glBindVertexArray(0);
 
 	Shader shader("assets/shaders/basic.vert", "assets/shaders/basic.frag");
-	if (!shader.IsValid())
+	Shader bodyShader("assets/shaders/instanced.vert", "assets/shaders/basic.frag");
+	if (!shader.IsValid() || !bodyShader.IsValid())
 	{
 		glfwDestroyWindow(window);
 		glfwTerminate();
@@ -143,7 +167,76 @@ int main()
 	/// - Player, enemies, levels, scores, etc.
 	/// ========================================================================
 
-	SnakeGame snake(32, 18);
+	// Fresh seed per launch; each R press draws the next one
+	SnakeRng seedSource(glfwGetTimerValue());
+	// Walls from level.snlv when there is one (see build-level); a damaged
+	// file is ignored
+	std::shared_ptr<LevelMap> level = std::make_shared<LevelMap>();
+	if (!level->Open("level.snlv") || !level->Verify())
+		level.reset();
+	SnakeGame snake = level ? SnakeGame(level, seedSource.Next()) : SnakeGame(32, 18, seedSource.Next());
+
+	// Every run is recorded; P replays the last one after game over
+	SnakeReplay lastRun;
+	SnakeReplayPlayer replayPlayer;
+	float replaySpeed = 4.0f;
+	snake.SetRecorder(&lastRun);
+	snake.Reset();
+
+	// Finished runs are appended to runs.snar (see archive-games); the
+	// archive holds open-board games only, so level runs are not kept
+	SnakeArchiveWriter runArchive;
+	const bool archiving = !level && runArchive.Open("runs.snar");
+	bool runArchived = false;
+
+	// Controller: keyboard or one of the bots (A = autopilot, H = Hamiltonian
+	// solver, M = MCTS, N = evolved MLP); pressing the same key again hands
+	// control back
+	enum class Controller { Keyboard, Autopilot, Hamiltonian, Mcts, Mlp };
+	Controller controller = Controller::Keyboard;
+	SnakeAutopilot autopilot(snake.GetGridW(), snake.GetGridH());
+	HamiltonianSolver solver(snake.GetGridW(), snake.GetGridH());
+	WorkStealingPool mctsPool;
+	SnakeMcts mcts(mctsPool, snake);
+	mcts.SetBudget(snake.GetStepTime() * 0.5f); // searches inside one step
+
+	// MCTS blocks for its whole budget, so it runs on its own thread from a
+	// copy of the game; frames keep drawing and the move is applied when
+	// it arrives (dropped if the game moved on meanwhile)
+	std::unique_ptr<SnakeGame> mctsGame;
+	MctsStats mctsStats;
+	std::future<Dir> mctsMove; // after mcts and mctsGame: waits for the search on exit
+	SnakeMlp policy;
+	SnakeMlpScratch policyScratch;
+	const bool hasPolicy = policy.Load("snake_policy.bin"); // train-ga --save snake_policy.bin
+	float botAcc = 0.0f;
+
+	// Body cells live on the GPU and follow the step events (new head,
+	// freed tail); a reset, an overflowed frame or the replay rebuilds them
+	InstanceRing bodyMesh;
+	bodyMesh.Init(vbo, snake.GetGridW() * snake.GetGridH());
+	bool bodyMeshLive = false; // mirrors the live game
+
+	// Walls never move: uploaded once
+	InstanceRing wallMesh;
+	if (level)
+	{
+		std::vector<float> wallCells;
+		for (int y = 0; y < level->GetGridH(); ++y)
+			for (int x = 0; x < level->GetGridW(); ++x)
+				if (level->IsWall({ x, y }))
+				{
+					wallCells.push_back(float(x));
+					wallCells.push_back(float(y));
+				}
+		wallMesh.Init(vbo, int(wallCells.size() / 2) + 1);
+		wallMesh.Assign(wallCells.data(), int(wallCells.size() / 2));
+	}
+
+	// The Hamiltonian cycle covers the whole board, walls included
+	const bool solverUsable = solver.IsSupported() && !level;
+	StepEventList frameEvents;
+	std::vector<float> bodyCells;
 
 	// ---- ImGui init (once) ----
 	IMGUI_CHECKVERSION();
@@ -201,12 +294,93 @@ int main()
 
 		if (currR && !prevR)
 		{
-			snake.Reset();
+			replayPlayer.Stop();
+			snake.Reset(seedSource.Next());
+			runArchived = false;
+			bodyMeshLive = false;
 		}
 
 		prevR = currR;
 
-		snake.Update(dt);
+		static bool prevP = false;
+		bool currP = glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS;
+
+		if (currP && !prevP && snake.IsGameOver())
+		{
+			if (replayPlayer.IsPlaying())
+				replayPlayer.Stop();
+			else
+				replayPlayer.Start(lastRun, level);
+		}
+
+		prevP = currP;
+
+		static bool prevBotKey[4] = {};
+		const int botKeys[4] = { GLFW_KEY_A, GLFW_KEY_H, GLFW_KEY_M, GLFW_KEY_N };
+
+		for (int i = 0; i < 4; ++i)
+		{
+			bool curr = glfwGetKey(window, botKeys[i]) == GLFW_PRESS;
+			if (curr && !prevBotKey[i])
+			{
+				const Controller bot = Controller(i + 1);
+				controller = controller == bot ? Controller::Keyboard : bot;
+			}
+			prevBotKey[i] = curr;
+		}
+
+		if (controller == Controller::Hamiltonian && !solverUsable)
+			controller = Controller::Keyboard;
+		if (controller == Controller::Mlp && !hasPolicy)
+			controller = Controller::Keyboard;
+
+		frameEvents.Clear();
+		if (controller != Controller::Keyboard)
+		{
+			// Same fixed step as Update, with a decision before every step
+			botAcc += dt;
+			while (botAcc >= snake.GetStepTime() && !snake.IsGameOver())
+			{
+				if (controller == Controller::Autopilot)
+					autopilot.Drive(snake);
+				else if (controller == Controller::Hamiltonian)
+					solver.Drive(snake);
+				else if (controller == Controller::Mcts)
+				{
+					if (mctsMove.valid() && mctsMove.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+						break; // still searching: the step waits, the frame does not
+
+					const bool fresh = mctsMove.valid() && mctsGame->GetHash() == snake.GetHash() &&
+						mctsGame->GetLength() == snake.GetLength();
+					const Dir move = mctsMove.valid() ? mctsMove.get() : snake.GetDir();
+					if (!fresh)
+					{
+						mctsGame = std::make_unique<SnakeGame>(snake);
+						mctsGame->SetRecorder(nullptr);
+						mctsMove = std::async(std::launch::async, [&mcts, &mctsGame] { return mcts.Decide(*mctsGame); });
+						break;
+					}
+					mctsStats = mcts.GetLastStats();
+					snake.SetPendingDir(move);
+				}
+				else
+					policy.Drive(snake, policyScratch);
+				frameEvents.Push(snake.Tick());
+				botAcc -= snake.GetStepTime();
+			}
+		}
+		else
+		{
+			botAcc = 0.0f;
+			frameEvents = snake.Update(dt);
+		}
+
+		if (snake.IsGameOver() && !runArchived)
+		{
+			if (archiving && runArchive.Append(lastRun, snake.GetScore()))
+				runArchive.Commit();
+			runArchived = true;
+		}
 
 #pragma endregion
 
@@ -216,6 +390,10 @@ int main()
 		/// - Update game logic.
 		/// - Movement, collision, AI, scoring, etc.
 		/// --------------------------------------------------------------------
+		replayPlayer.Update(dt, replaySpeed);
+
+		// Render whichever game is on screen: live run or replay
+		const SnakeGame& view = replayPlayer.IsPlaying() ? replayPlayer.GetGame() : snake;
 #pragma endregion
 
 #pragma region World_Render
@@ -226,8 +404,8 @@ int main()
 		/// --------------------------------------------------------------------
 		shader.Use();
 
-		const int gw = snake.GetGridW();
-		const int gh = snake.GetGridH();
+		const int gw = view.GetGridW();
+		const int gh = view.GetGridH();
 
 		// cell size in NDC ([-1, +1])
 		const float cellW = 2.0f / float(gw);
@@ -247,32 +425,67 @@ int main()
 
 		glBindVertexArray(vao);
 
-		// --- draw food (red) ---
+		// --- draw food (red, none once the board is full) ---
+		if (!view.IsWon())
 		{
-			const Cell& f = snake.GetFood();
+			const Cell& f = view.GetFood();
 			auto [fx, fy] = cellToNDC(f.x, f.y);
 			shader.SetVec3("uColor", 1.0f, 0.0f, 0.0f);
 			shader.SetVec2("uOffset", fx, fy);
 			glDrawArrays(GL_TRIANGLES, 0, 6);
 		}
 
-		// --- draw body (green) ---
+		// --- draw walls (grey) ---
+		if (level)
 		{
-			shader.SetVec3("uColor", 0.0f, 1.0f, 0.0f);
-			const auto& body = snake.GetBody();
+			bodyShader.Use();
+			bodyShader.SetVec2("uScale", cellW, cellH);
+			bodyShader.SetVec3("uColor", 0.45f, 0.45f, 0.45f);
+			wallMesh.Draw();
+
+			shader.Use();
+			glBindVertexArray(vao);
+		}
 
-			// draw every segment
-			for (const Cell& c : body)
+		// --- draw body (green) ---
+		{
+			// Live game: apply this frame's steps, O(1) each. Otherwise
+			// upload the whole body (replay, reset, more steps than the list holds)
+			const bool live = !replayPlayer.IsPlaying();
+			if (live && bodyMeshLive && !frameEvents.overflowed)
+			{
+				for (const StepEvent& e : frameEvents)
+				{
+					if (e.flags & StepEvent::Moved)
+						bodyMesh.PushFront(float(e.added.x), float(e.added.y));
+					if (e.removed.x >= 0)
+						bodyMesh.PopBack();
+				}
+			}
+			else
 			{
-				auto [ox, oy] = cellToNDC(c.x, c.y);
-				shader.SetVec2("uOffset", ox, oy);
-				glDrawArrays(GL_TRIANGLES, 0, 6);
+				bodyCells.clear();
+				view.GetBody().ForEach([&](const Cell& c)
+					{
+						bodyCells.push_back(float(c.x));
+						bodyCells.push_back(float(c.y));
+					});
+				bodyMesh.Assign(bodyCells.data(), view.GetLength());
+				bodyMeshLive = live;
 			}
+
+			bodyShader.Use();
+			bodyShader.SetVec2("uScale", cellW, cellH);
+			bodyShader.SetVec3("uColor", 0.0f, 1.0f, 0.0f);
+			bodyMesh.Draw();
+
+			shader.Use();
+			glBindVertexArray(vao);
 		}
 
 		// --- draw head (brighter green) ---
 		{
-			const Cell& h = snake.GetHead();
+			const Cell& h = view.GetHead();
 			auto [hx, hy] = cellToNDC(h.x, h.y);
 			shader.SetVec3("uColor", 0.2f, 1.0f, 0.2f);
 			shader.SetVec2("uOffset", hx, hy);
@@ -292,19 +505,55 @@ int main()
 		ImGui_ImplGlfw_NewFrame();
 		ImGui::NewFrame();
 
-		ImGui::SetNextWindowSize(ImVec2(260, 140), ImGuiCond_Always);
+		ImGui::SetNextWindowSize(ImVec2(260, 280), ImGuiCond_Always);
 		ImGui::Begin("Snake");
 
-		ImGui::Text("Score (Length): %d", snake.GetScore());
-		ImGui::Text("Length: %d", (int)snake.GetBody().size());
+		ImGui::Text("Score (Length): %d", view.GetScore());
+		ImGui::Text("Length: %d", view.GetLength());
 
-		if (snake.IsGameOver())
+		int controllerIndex = int(controller);
+		ImGui::RadioButton("Keyboard", &controllerIndex, 0);
+		ImGui::SameLine();
+		ImGui::RadioButton("Autopilot (A)", &controllerIndex, 1);
+		if (solverUsable)
+		{
+			ImGui::RadioButton("Hamiltonian (H)", &controllerIndex, 2);
+			ImGui::SameLine();
+		}
+		ImGui::RadioButton("MCTS (M)", &controllerIndex, 3);
+		if (hasPolicy)
+		{
+			ImGui::SameLine();
+			ImGui::RadioButton("MLP (N)", &controllerIndex, 4);
+		}
+		controller = Controller(controllerIndex);
+
+		if (controller == Controller::Mcts)
+		{
+			ImGui::Text("MCTS: %.0fk rollouts/s, %d nodes", mctsStats.RolloutsPerSec() / 1000.0, mctsStats.nodes);
+		}
+
+		if (view.IsGameOver())
 		{
 			ImGui::Separator();
-			ImGui::TextColored(ImVec4(1, 0, 0, 1), "GAME OVER");
+			if (view.IsWon())
+				ImGui::TextColored(ImVec4(0, 1, 0, 1), "YOU WIN");
+			else
+				ImGui::TextColored(ImVec4(1, 0, 0, 1), "GAME OVER");
 			ImGui::Text("Press R to restart");
 		}
 
+		if (replayPlayer.IsPlaying())
+		{
+			ImGui::Separator();
+			ImGui::Text("Replay: step %llu / %llu", (unsigned long long)replayPlayer.GetStep(),
+				(unsigned long long)lastRun.GetStepCount());
+			ImGui::SliderFloat("Speed", &replaySpeed, 0.25f, 1024.0f, "%.2fx", ImGuiSliderFlags_Logarithmic);
+			ImGui::Text("Press P to stop");
+		}
+		else if (snake.IsGameOver())
+			ImGui::Text("Press P to watch the replay");
+
 		ImGui::End();
 
 
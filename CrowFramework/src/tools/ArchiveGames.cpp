@@ -0,0 +1,230 @@
+#include <tools/ToolArgs.h>
+#include <tools/ToolPolicies.h>
+#include <engine/WorkStealingPool.h>
+#include <game/SnakeArchive.h>
+#include <game/SnakeGame.h>
+#include <game/SnakeReplay.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double Seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Record games [first, first + count) in parallel and append them in order
+static bool RecordChunk(WorkStealingPool& pool, std::vector<std::unique_ptr<SnakeGame>>& games,
+	std::vector<SnakeReplay>& replays, std::vector<int>& scores, uint64_t seed0, int count,
+	SnakeArchiveWriter& writer, uint64_t& steps)
+{
+	pool.ParallelFor(0, count, 64, [&](int64_t begin, int64_t end, int worker)
+		{
+			SnakeGame& game = *games[size_t(worker)];
+			for (int64_t i = begin; i < end; ++i)
+			{
+				const uint64_t seed = seed0 + uint64_t(i);
+				game.SetRecorder(&replays[size_t(i)]);
+				game.Reset(seed);
+				SnakeRng policyRng = SnakeRng::ForStream(seed, 1);
+
+				const int cap = 200 * game.GetGridW() * game.GetGridH();
+				for (int s = 0; !game.IsGameOver() && s < cap; ++s)
+				{
+					game.SetPendingDir(GreedyPolicy(game, policyRng));
+					game.Tick();
+				}
+				game.SetRecorder(nullptr);
+				scores[size_t(i)] = game.GetScore();
+			}
+		});
+
+	for (int i = 0; i < count; ++i)
+	{
+		if (!writer.Append(replays[size_t(i)], scores[size_t(i)])) return false;
+		steps += replays[size_t(i)].GetStepCount();
+	}
+	return true;
+}
+
+// Re-simulate every archived game straight from the mapping
+static int VerifyAll(WorkStealingPool& pool, const SnakeArchiveReader& reader, uint64_t& steps)
+{
+	std::vector<std::unique_ptr<SnakeGame>> games(size_t(pool.GetThreadCount()));
+	std::atomic<int> mismatches(0);
+	std::atomic<uint64_t> total(0);
+
+	pool.ParallelFor(0, int64_t(reader.GetCount()), 256, [&](int64_t begin, int64_t end, int worker)
+		{
+			std::unique_ptr<SnakeGame>& game = games[size_t(worker)];
+			uint64_t localSteps = 0;
+			int bad = 0;
+			for (int64_t i = begin; i < end; ++i)
+			{
+				// Damaged records never reach a game
+				if (!reader.CheckRecord(uint64_t(i)))
+				{
+					++bad;
+					continue;
+				}
+
+				const ArchivedGame a = reader.Get(uint64_t(i));
+				if (!game || game->GetGridW() != a.gridW || game->GetGridH() != a.gridH)
+					game = std::make_unique<SnakeGame>(a.gridW, a.gridH);
+
+				const SnakeReplayResult r = SimulatePackedReplay(*game, a.seed, a.packed, a.steps);
+				bad += !r.valid || r.steps != a.steps || r.score != a.score;
+				localSteps += a.steps;
+			}
+			mismatches += bad;
+			total += localSteps;
+		});
+
+	steps = total.load();
+	return mismatches.load();
+}
+
+// Copy the archive, cut `cut` bytes off the end, and count what a reader recovers
+static void TornCopy(const char* path, uint64_t cut, const char* what, uint64_t expected)
+{
+	const std::string torn = std::string(path) + ".torn";
+	std::error_code ec;
+	std::filesystem::copy_file(path, torn, std::filesystem::copy_options::overwrite_existing, ec);
+	const uint64_t size = std::filesystem::file_size(torn, ec);
+	std::filesystem::resize_file(torn, size - cut, ec);
+
+	SnakeArchiveReader reader;
+	const bool ok = !ec && reader.Open(torn.c_str());
+	std::cout << "    " << what << ": " << (ok ? reader.GetCount() : 0) << " games"
+		<< (ok && reader.WasRecovered() ? " recovered" : "") << " (expected " << expected << ")\n";
+	reader.Close();
+	std::filesystem::remove(torn, ec);
+}
+
+int ArchiveGames(const ToolArgs& args)
+{
+	const char* path = args.Get("--file", "games.snar");
+	const int count = int(args.GetInt("--games", 100000));
+	const int w = int(args.GetInt("--grid-w", 32));
+	const int h = int(args.GetInt("--grid-h", 18));
+	const uint64_t seed0 = uint64_t(args.GetInt("--seed", 1));
+	const int maxThreads = int(args.GetInt("--threads", WorkStealingPool::HardwareThreads()));
+	const int chunk = 4096;
+
+	std::cout << "archive-games: " << path << "\n" << std::fixed;
+
+	// Record in chunks: games in parallel, appends in seed order
+	if (count > 0)
+	{
+		std::error_code ec;
+		std::filesystem::remove(path, ec);
+
+		WorkStealingPool pool(maxThreads);
+		std::vector<std::unique_ptr<SnakeGame>> games;
+		for (int i = 0; i < pool.GetThreadCount(); ++i)
+			games.push_back(std::make_unique<SnakeGame>(w, h));
+		std::vector<SnakeReplay> replays(size_t(std::min(chunk, count)));
+		std::vector<int> scores(replays.size());
+
+		SnakeArchiveWriter writer;
+		if (!writer.Open(path))
+		{
+			std::cout << "  cannot create " << path << "\n";
+			return 1;
+		}
+
+		auto start = Clock::now();
+		uint64_t steps = 0;
+		for (int first = 0; first < count; first += chunk)
+		{
+			const int n = std::min(chunk, count - first);
+			if (!RecordChunk(pool, games, replays, scores, seed0 + uint64_t(first), n, writer, steps))
+			{
+				std::cout << "  write failed\n";
+				return 1;
+			}
+		}
+		if (!writer.Close())
+		{
+			std::cout << "  commit failed\n";
+			return 1;
+		}
+		const double sec = Seconds(start);
+		std::cout << "  recorded " << count << " games on " << w << "x" << h << " (" << steps << " steps) in "
+			<< std::setprecision(2) << sec << " s, " << pool.GetThreadCount() << " threads\n";
+	}
+
+	SnakeArchiveReader reader;
+	auto openStart = Clock::now();
+	if (!reader.Open(path))
+	{
+		std::cout << "  cannot open " << path << "\n";
+		return 1;
+	}
+	const double openSec = Seconds(openStart);
+	const uint64_t n = reader.GetCount();
+	std::cout << "  mapped " << std::setprecision(1) << double(reader.GetFileSize()) / (1024.0 * 1024.0) << " MB, "
+		<< n << " games (" << (n ? double(reader.GetFileSize()) / double(n) : 0.0) << " bytes each), index "
+		<< (reader.WasRecovered() ? "rebuilt from records" : "from footer") << ", open "
+		<< std::setprecision(2) << openSec * 1e3 << " ms\n";
+	if (n == 0) return 0;
+
+	// O(1) random access: header and first payload byte of random games
+	{
+		SnakeRng rng(11);
+		const int seeks = 1000000;
+		uint64_t sink = 0;
+		auto start = Clock::now();
+		for (int i = 0; i < seeks; ++i)
+		{
+			const ArchivedGame a = reader.Get(rng.Next() % n);
+			sink += a.steps + (a.steps ? a.packed[0] : 0);
+		}
+		const double sec = Seconds(start);
+		std::cout << "  random seek: " << std::setprecision(1) << sec * 1e9 / seeks << " ns per game (checksum " << (sink & 0xFFFF) << ")\n";
+	}
+
+	// Verify on every core, then the scaling curve
+	int failures = 0;
+	std::cout << "  verify (re-simulate + record hash):\n";
+	double baseRate = 0.0;
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		WorkStealingPool pool(threads);
+		uint64_t steps = 0;
+		auto start = Clock::now();
+		const int mismatches = VerifyAll(pool, reader, steps);
+		const double sec = Seconds(start);
+		const double rate = double(n) / sec;
+		if (threads == 1) baseRate = rate;
+		failures += mismatches;
+
+		std::cout << "    " << std::setw(2) << threads << " threads: " << std::setprecision(0) << std::setw(9) << rate
+			<< " games/s, " << std::setprecision(1) << double(steps) / sec / 1e6 << " M steps/s ("
+			<< std::setprecision(2) << rate / baseRate << "x), " << (mismatches ? "MISMATCH " : "all match ")
+			<< mismatches << "\n";
+	}
+	if (maxThreads < 2)
+		std::cout << "    (one hardware thread: pass --threads N to run more)\n";
+
+	// Crash check on copies: torn footer, then a torn last record
+	if (!reader.WasRecovered())
+	{
+		const uint64_t footerAndIndex = reader.GetFileSize() - reader.GetDataEnd();
+		reader.Close();
+		std::cout << "  crash check:\n";
+		TornCopy(path, 8, "footer cut short", n);
+		TornCopy(path, footerAndIndex + 5, "last record cut short", n - 1);
+	}
+
+	return failures ? 1 : 0;
+}
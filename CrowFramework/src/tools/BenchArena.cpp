@@ -0,0 +1,137 @@
+#include <tools/ToolArgs.h>
+#include <engine/WorkStealingPool.h>
+#include <game/SnakeArena.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+using Clock = std::chrono::steady_clock;
+
+static double Seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Each snake chases one food slot, avoiding walls and bodies
+static void SteerAll(SnakeArena& arena, SnakeRng& rng)
+{
+	const std::vector<Cell>& food = arena.GetFood();
+	for (int id = 0; id < arena.GetSnakeCount(); ++id)
+	{
+		if (!arena.IsAlive(id)) continue;
+		const Cell head = arena.GetHead(id);
+		const Cell goal = food[size_t(id) % food.size()];
+
+		Dir best = arena.GetDir(id);
+		int bestCost = 1 << 30;
+		for (int i = 0; i < 4; ++i)
+		{
+			const Dir d = Dir(i);
+			const Cell c = Neighbor(head, d);
+			if (arena.IsBlocked(c)) continue;
+
+			const int cost = (std::abs(c.x - goal.x) + std::abs(c.y - goal.y)) * 4 + int(rng.NextBelow(4));
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				best = d;
+			}
+		}
+		arena.SetPendingDir(id, best);
+	}
+}
+
+struct ArenaRun
+{
+	double tickSec = 0.0;   // inside Tick only
+	uint64_t moves = 0;     // living snakes moved
+	uint64_t deaths[5] = {};
+	uint64_t hash = 0;      // final state, for the thread-count check
+};
+
+// ticks ticks; a fresh round starts when half the snakes are gone
+static ArenaRun RunArena(SnakeArena& arena, int ticks, WorkStealingPool* pool)
+{
+	SnakeRng rng(3);
+	ArenaRun run;
+	uint64_t round = 0;
+	arena.Reset(1);
+
+	for (int t = 0; t < ticks; ++t)
+	{
+		if (arena.GetAliveCount() * 2 < arena.GetSnakeCount())
+		{
+			for (int id = 0; id < arena.GetSnakeCount(); ++id)
+				run.deaths[int(arena.GetDeathCause(id))]++;
+			arena.Reset(++round + 1);
+		}
+
+		SteerAll(arena, rng);
+		run.moves += uint64_t(arena.GetAliveCount());
+		auto start = Clock::now();
+		arena.Tick(pool);
+		run.tickSec += Seconds(start);
+	}
+
+	uint64_t h = 0xCBF29CE484222325ull;
+	auto mix = [&](uint64_t v) { h = (h ^ v) * 0x100000001B3ull; };
+	for (int id = 0; id < arena.GetSnakeCount(); ++id)
+	{
+		mix(uint64_t(arena.GetLength(id)));
+		mix(uint64_t(arena.GetDeathCause(id)));
+		if (arena.IsAlive(id)) mix(uint64_t(arena.GetHead(id).x) << 32 | uint64_t(arena.GetHead(id).y));
+	}
+	for (const Cell& f : arena.GetFood())
+		mix(uint64_t(uint32_t(f.x)) << 32 | uint64_t(uint32_t(f.y)));
+	run.hash = h;
+	return run;
+}
+
+int BenchArena(const ToolArgs& args)
+{
+	const int w = int(args.GetInt("--grid-w", 1024));
+	const int h = int(args.GetInt("--grid-h", 1024));
+	const int ticks = int(args.GetInt("--ticks", 2000));
+	const int maxSnakes = int(args.GetInt("--snakes", 16384));
+	const int maxThreads = int(args.GetInt("--threads", WorkStealingPool::HardwareThreads()));
+
+	std::cout << "bench-arena: " << w << "x" << h << ", " << ticks << " ticks, food = snakes / 2\n" << std::fixed;
+
+	// Linear in snakes: ns per snake move should hold steady
+	std::cout << "  inline tick cost by snake count:\n";
+	for (int snakes = 64; snakes <= maxSnakes; snakes *= 4)
+	{
+		SnakeArena arena(w, h, snakes, snakes / 2 + 1);
+		const ArenaRun r = RunArena(arena, ticks, nullptr);
+		std::cout << "    " << std::setw(6) << snakes << " snakes: " << std::setprecision(1) << std::setw(7)
+			<< double(ticks) / r.tickSec << " ticks/s, " << std::setprecision(1) << r.tickSec * 1e9 / double(r.moves)
+			<< " ns per snake move; deaths wall " << r.deaths[int(DeathCause::Wall)] << ", self "
+			<< r.deaths[int(DeathCause::Self)] << ", other body " << r.deaths[int(DeathCause::Snake)]
+			<< ", head-on " << r.deaths[int(DeathCause::HeadOn)] << "\n";
+	}
+
+	// Region-parallel ticks must land on the inline result, bit for bit
+	int failures = 0;
+	SnakeArena arena(w, h, maxSnakes, maxSnakes / 2 + 1);
+	const ArenaRun base = RunArena(arena, ticks, nullptr);
+	std::cout << "  " << maxSnakes << " snakes over thread counts (inline " << std::setprecision(1)
+		<< double(ticks) / base.tickSec << " ticks/s):\n";
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		WorkStealingPool pool(threads);
+		const ArenaRun r = RunArena(arena, ticks, &pool);
+		const bool same = r.hash == base.hash;
+		failures += !same;
+		std::cout << "    " << std::setw(2) << threads << " threads: " << std::setprecision(1) << std::setw(7)
+			<< double(ticks) / r.tickSec << " ticks/s (" << std::setprecision(2) << base.tickSec / r.tickSec
+			<< "x inline), state " << (same ? "matches inline" : "MISMATCH") << "\n";
+	}
+	if (maxThreads < 2)
+		std::cout << "    (one hardware thread: pass --threads N to run more)\n";
+
+	return failures ? 1 : 0;
+}
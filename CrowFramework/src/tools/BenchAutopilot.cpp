@@ -0,0 +1,90 @@
+#include <tools/ToolArgs.h>
+#include <engine/WorkStealingPool.h>
+#include <game/SnakeAutopilot.h>
+#include <game/SnakeGame.h>
+#include <game/SnakeRunner.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+int BenchAutopilot(const ToolArgs& args)
+{
+	const int w = int(args.GetInt("--grid-w", 64));
+	const int h = int(args.GetInt("--grid-h", 64));
+	const int games = int(args.GetInt("--games", 4));
+	const int threads = int(args.GetInt("--threads", WorkStealingPool::HardwareThreads()));
+	const int episodes = int(args.GetInt("--episodes", 64));
+	const int maxSteps = int(args.GetInt("--max-steps", 20000)); // per latency game
+
+	std::cout << "bench-autopilot: " << w << "x" << h << "\n";
+
+	// Decision latency, one game at a time on this thread
+	SnakeGame game(w, h);
+	SnakeAutopilot pilot(w, h);
+	std::vector<float> micros;
+	micros.reserve(1 << 20);
+	int64_t scoreSum = 0;
+	int wins = 0;
+
+	for (int g = 0; g < games; ++g)
+	{
+		game.Reset(uint64_t(g) + 1);
+		int hungry = 0;
+		int lastLength = game.GetLength();
+		for (int s = 0; s < maxSteps && !game.IsGameOver() && hungry < w * h * 4; ++s)
+		{
+			auto start = Clock::now();
+			const Dir d = pilot.Decide(game);
+			micros.push_back(std::chrono::duration<float, std::micro>(Clock::now() - start).count());
+
+			game.SetPendingDir(d);
+			game.Tick();
+			hungry = game.GetLength() == lastLength ? hungry + 1 : 0;
+			lastLength = game.GetLength();
+		}
+		scoreSum += game.GetScore();
+		wins += game.IsWon();
+	}
+
+	std::vector<float> sorted = micros;
+	std::sort(sorted.begin(), sorted.end());
+	double total = 0.0;
+	for (float m : micros) total += m;
+
+	const size_t n = sorted.size();
+	std::cout << std::fixed << std::setprecision(2)
+		<< "  " << games << " games, " << n << " decisions, mean score " << double(scoreSum) / games
+		<< " of " << w * h - 3 << ", won " << wins << " (max " << maxSteps << " steps each)\n"
+		<< "  decide: mean " << total / double(n) << " us, p50 " << sorted[n / 2]
+		<< " us, p99 " << sorted[n * 99 / 100] << " us, max " << sorted[n - 1] << " us\n";
+
+	// Load generator: autopilot episodes across the pool, one pilot per worker
+	WorkStealingPool pool(threads);
+	std::vector<std::unique_ptr<SnakeAutopilot>> pilots;
+	for (int i = 0; i < pool.GetThreadCount(); ++i)
+		pilots.push_back(std::make_unique<SnakeAutopilot>(w, h));
+
+	RunnerConfig config;
+	config.gridW = w;
+	config.gridH = h;
+	config.seedBegin = 1000;
+	config.seedEnd = 1000 + uint64_t(episodes);
+	config.starveSteps = w * h * 4;
+	config.grain = 1;
+
+	RunnerStats stats = RunEpisodes(pool, config,
+		[&](const SnakeGame& g, SnakeRng&, int worker) { return pilots[size_t(worker)]->Decide(g); });
+
+	std::cout << "  runner: " << stats.episodes << " episodes on " << pool.GetThreadCount() << " threads, "
+		<< std::setprecision(0) << double(stats.steps) / stats.seconds << " steps/s, mean score "
+		<< std::setprecision(1) << stats.MeanScore() << ", won " << stats.ends[int(EpisodeEnd::Won)]
+		<< ", starved " << stats.ends[int(EpisodeEnd::Starved)] << "\n";
+	return 0;
+}
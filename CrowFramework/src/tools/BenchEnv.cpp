@@ -0,0 +1,171 @@
+#include <tools/ToolArgs.h>
+#include <game/SnakeGame.h>
+#include <game/SnakeRng.h>
+#include <game/SnakeVecEnv.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Obs planes of a SnakeGame, written from scratch
+static void ReferenceObs(const SnakeGame& game, uint8_t* obs)
+{
+	const size_t cells = size_t(game.GetGridW()) * size_t(game.GetGridH());
+	std::memset(obs, 0, cells * SnakeVecEnv::kPlanes);
+
+	uint8_t* body = obs + cells * SnakeVecEnv::PlaneBody;
+	uint8_t* heads = obs + cells * SnakeVecEnv::PlaneHead;
+	uint8_t* foods = obs + cells * SnakeVecEnv::PlaneFood;
+	bool first = true;
+	game.GetBody().ForEach([&](const Cell& c)
+		{
+			(first ? heads : body)[size_t(c.y) * size_t(game.GetGridW()) + size_t(c.x)] = 1;
+			first = false;
+		});
+	const Cell food = game.GetFood();
+	if (food.x >= 0) foods[size_t(food.y) * size_t(game.GetGridW()) + size_t(food.x)] = 1;
+}
+
+// Random actions into a sharded env and into one reference SnakeGame per
+// env, with the env's rules applied by hand (rewards, starvation, reset to
+// seed + envs). Obs, rewards, dones and final scores must agree every step.
+// Returns the number of disagreeing (step, env) pairs
+static long long CrossCheck(int envs, int steps, int w, int h, int threads, int starveSteps)
+{
+	SnakeVecEnv env(envs, w, h, threads, starveSteps);
+	const size_t n = size_t(envs);
+	const size_t obsSize = env.GetObsSize();
+	std::vector<uint8_t> obs(n * obsSize), expectObs(obsSize);
+	std::vector<float> rewards(n);
+	std::vector<uint8_t> dones(n), actions(n);
+	std::vector<int32_t> finalScores(n);
+	std::vector<uint64_t> seeds(n);
+	std::vector<int> hungry(n, 0);
+	std::vector<std::unique_ptr<SnakeGame>> refs;
+	for (size_t i = 0; i < n; ++i)
+	{
+		seeds[i] = uint64_t(i) + 1;
+		refs.push_back(std::make_unique<SnakeGame>(w, h, seeds[i]));
+	}
+
+	env.SetBuffers(obs.data(), rewards.data(), dones.data(), finalScores.data());
+	env.Reset(seeds.data());
+
+	SnakeRng rng(11);
+	long long mismatches = 0;
+	uint64_t episodes = 0, truncated = 0;
+	for (int s = 0; s < steps; ++s)
+	{
+		for (uint8_t& a : actions)
+			a = uint8_t(rng.NextBelow(4));
+		env.Step(actions.data());
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			SnakeGame& g = *refs[i];
+			const int before = g.GetLength();
+			g.SetPendingDir(Dir(actions[i]));
+			g.Tick();
+
+			const float reward = g.IsGameOver() && !g.IsWon() ? -1.0f : (g.GetLength() != before ? 1.0f : 0.0f);
+			uint8_t done = g.IsGameOver() ? SnakeVecEnv::Terminated : SnakeVecEnv::Running;
+			if (!done)
+			{
+				hungry[i] = g.GetLength() != before ? 0 : hungry[i] + 1;
+				if (hungry[i] >= starveSteps) done = SnakeVecEnv::Truncated;
+			}
+			const int32_t finalScore = done ? g.GetScore() : -1;
+
+			if (done)
+			{
+				episodes++;
+				truncated += done == SnakeVecEnv::Truncated;
+				seeds[i] += n;
+				g.Reset(seeds[i]);
+				hungry[i] = 0;
+			}
+
+			ReferenceObs(g, expectObs.data());
+			const bool ok = rewards[i] == reward && dones[i] == done && finalScores[i] == finalScore &&
+				std::memcmp(obs.data() + i * obsSize, expectObs.data(), obsSize) == 0;
+			mismatches += !ok;
+		}
+	}
+
+	std::cout << "  cross-check: " << envs << " envs on " << threads << " shards x " << steps << " steps, " << episodes
+		<< " episodes (" << truncated << " starved) vs SnakeGame: obs, rewards, dones, final scores "
+		<< (mismatches ? "MISMATCH " : "all match ") << mismatches << "\n";
+	return mismatches;
+}
+
+int BenchEnv(const ToolArgs& args)
+{
+	const int envs = int(args.GetInt("--envs", 4096));
+	const int steps = int(args.GetInt("--steps", 2000));
+	const int w = int(args.GetInt("--grid-w", 32));
+	const int h = int(args.GetInt("--grid-h", 18));
+	const int threads = int(args.GetInt("--threads", 1));
+
+	SnakeVecEnv env(envs, w, h, threads);
+
+	// Caller-owned buffers, as a training loop would hold them
+	const size_t n = size_t(envs);
+	std::vector<uint8_t> obs(n * env.GetObsSize());
+	std::vector<float> rewards(n);
+	std::vector<uint8_t> dones(n);
+	std::vector<int32_t> finalScores(n);
+	std::vector<uint64_t> seeds(n);
+	for (size_t i = 0; i < n; ++i)
+		seeds[i] = uint64_t(i) + 1;
+
+	env.SetBuffers(obs.data(), rewards.data(), dones.data(), finalScores.data());
+	env.Reset(seeds.data());
+
+	// Random actions, drawn up front so the loop times the env alone
+	SnakeRng rng(7);
+	std::vector<uint8_t> actionTable(n * 64);
+	for (uint8_t& a : actionTable)
+		a = uint8_t(rng.NextBelow(4));
+
+	uint64_t episodes = 0, truncated = 0;
+	int64_t scoreSum = 0;
+	double rewardSum = 0.0;
+
+	auto start = Clock::now();
+	for (int s = 0; s < steps; ++s)
+	{
+		env.Step(actionTable.data() + size_t(s & 63) * n);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			rewardSum += rewards[i];
+			if (finalScores[i] >= 0)
+			{
+				episodes++;
+				scoreSum += finalScores[i];
+				truncated += dones[i] == SnakeVecEnv::Truncated;
+			}
+		}
+	}
+	const double sec = std::chrono::duration<double>(Clock::now() - start).count();
+	const double total = double(envs) * double(steps);
+
+	std::cout << "bench-env: " << envs << " envs on " << w << "x" << h << ", " << threads << " threads, "
+		<< steps << " steps, obs " << env.GetObsSize() << " bytes/env\n"
+		<< std::fixed << std::setprecision(2)
+		<< "  " << total / sec / 1e6 << " M env-steps/s (" << sec * 1e9 / total << " ns each, incl. obs and reading results)\n"
+		<< "  " << episodes << " episodes ended (" << truncated << " starved), mean score "
+		<< (episodes ? double(scoreSum) / double(episodes) : 0.0) << ", reward sum " << rewardSum << "\n";
+
+	// Short starvation limit so truncation is covered as well as death
+	const int checkEnvs = int(args.GetInt("--check-envs", 256));
+	const int checkSteps = int(args.GetInt("--check-steps", 5000));
+	const int checkThreads = int(args.GetInt("--check-threads", 3));
+	return CrossCheck(checkEnvs, checkSteps, w, h, checkThreads, 200) ? 1 : 0;
+}
@@ -0,0 +1,84 @@
+#include <tools/ToolArgs.h>
+#include <game/HamiltonianSolver.h>
+#include <game/SnakeGame.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+using Clock = std::chrono::steady_clock;
+
+int BenchFill(const ToolArgs& args)
+{
+	const int w = int(args.GetInt("--grid-w", 32));
+	const int h = int(args.GetInt("--grid-h", 18));
+	const int games = int(args.GetInt("--games", 20));
+	const double limit = args.GetDouble("--shortcut-limit", 0.5);
+
+	HamiltonianSolver solver(w, h, float(limit));
+	if (!solver.IsSupported())
+	{
+		std::cout << "bench-fill: " << w << "x" << h << " has no Hamiltonian cycle (both sides odd)\n";
+		return 1;
+	}
+
+	std::cout << "bench-fill: " << games << " games on " << w << "x" << h
+		<< ", shortcuts below " << std::setprecision(0) << std::fixed << limit * 100.0 << "% of the board\n";
+
+	// Time per step, bucketed by how full the board is when the step runs
+	const int kBuckets = 4;
+	double bucketSec[kBuckets] = {};
+	uint64_t bucketSteps[kBuckets] = {};
+
+	SnakeGame game(w, h);
+	const int cells = w * h;
+	const uint64_t maxSteps = uint64_t(cells) * uint64_t(cells);
+	int wins = 0;
+	uint64_t totalSteps = 0;
+
+	for (int g = 0; g < games; ++g)
+	{
+		game.Reset(uint64_t(g) + 1);
+		solver.Prepare(game);
+
+		uint64_t steps = 0;
+		while (!game.IsGameOver() && steps < maxSteps)
+		{
+			// Timed in runs of 64 steps to keep clock reads out of the numbers
+			const int bucket = game.GetLength() * kBuckets / (cells + 1);
+			auto start = Clock::now();
+			int n = 0;
+			for (; n < 64 && !game.IsGameOver(); ++n)
+			{
+				solver.Drive(game);
+				game.Tick();
+			}
+			bucketSec[bucket] += std::chrono::duration<double>(Clock::now() - start).count();
+			bucketSteps[bucket] += uint64_t(n);
+			steps += uint64_t(n);
+		}
+
+		wins += game.IsWon();
+		totalSteps += steps;
+		if (!game.IsWon())
+			std::cout << "  seed " << g + 1 << ": stopped at length " << game.GetLength() << " after " << steps << " steps\n";
+	}
+
+	double sec = 0.0;
+	for (double s : bucketSec) sec += s;
+
+	std::cout << "  won " << wins << " of " << games << ", " << std::setprecision(0)
+		<< double(totalSteps) / games << " steps per game (" << std::setprecision(1)
+		<< double(totalSteps) / games / cells << " per cell), " << std::setprecision(1)
+		<< double(totalSteps) / sec / 1e6 << " M steps/s incl. decisions\n";
+
+	for (int b = 0; b < kBuckets; ++b)
+	{
+		if (!bucketSteps[b]) continue;
+		std::cout << "  board " << std::setw(3) << b * 100 / kBuckets << "-" << std::setw(3) << (b + 1) * 100 / kBuckets
+			<< "% full: " << std::setw(10) << bucketSteps[b] << " steps, " << std::setprecision(1)
+			<< std::setw(6) << bucketSec[b] / double(bucketSteps[b]) * 1e9 << " ns/step\n";
+	}
+	return wins == games ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+#include <tools/ToolArgs.h>
+#include <engine/WorkStealingPool.h>
+#include <game/SnakeGame.h>
+#include <game/SnakeMcts.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+int BenchMcts(const ToolArgs& args)
+{
+	const int w = int(args.GetInt("--grid-w", 32));
+	const int h = int(args.GetInt("--grid-h", 18));
+	const int moves = int(args.GetInt("--moves", 20));
+	const double budgetMs = args.GetDouble("--budget-ms", 50.0);
+	const int maxThreads = int(args.GetInt("--threads", WorkStealingPool::HardwareThreads()));
+	const uint64_t seed = uint64_t(args.GetInt("--seed", 1));
+
+	MctsConfig config;
+	config.budget = float(budgetMs / 1000.0);
+	config.maxNodes = int(args.GetInt("--max-nodes", 1 << 20));
+	config.rolloutSteps = int(args.GetInt("--rollout-steps", 64));
+
+	std::cout << "bench-mcts: " << w << "x" << h << ", " << moves << " moves of "
+		<< budgetMs << " ms each, arena " << config.maxNodes << " nodes\n";
+
+	// Thread counts 1, 2, 4, ... and the maximum itself
+	std::vector<int> counts;
+	for (int t = 1; t < maxThreads; t *= 2)
+		counts.push_back(t);
+	counts.push_back(std::max(maxThreads, 1));
+
+	double baseRate = 0.0;
+	for (int threads : counts)
+	{
+		WorkStealingPool pool(threads);
+		SnakeGame game(w, h, seed);
+		SnakeMcts mcts(pool, game, config);
+
+		// Same game every run; the moves differ once thread timing does
+		uint64_t rollouts = 0;
+		double seconds = 0.0;
+		int64_t nodes = 0;
+		int maxDepth = 0;
+		int played = 0;
+		for (; played < moves && !game.IsGameOver(); ++played)
+		{
+			mcts.Drive(game);
+			game.Tick();
+
+			const MctsStats& s = mcts.GetLastStats();
+			rollouts += s.rollouts;
+			seconds += s.seconds;
+			nodes += s.nodes;
+			maxDepth = std::max(maxDepth, s.maxDepth);
+		}
+		if (!played) break;
+
+		const double rate = double(rollouts) / seconds;
+		if (threads == counts.front()) baseRate = rate;
+
+		std::cout << std::fixed << "  threads " << std::setw(3) << threads << ": "
+			<< std::setprecision(0) << std::setw(10) << rate << " rollouts/s ("
+			<< std::setprecision(2) << rate / baseRate << "x), tree "
+			<< std::setprecision(0) << std::setw(8) << double(nodes) / played << " nodes/move, depth "
+			<< std::setw(3) << maxDepth << ", length " << game.GetLength()
+			<< (game.IsGameOver() ? " (dead)" : "") << "\n";
+	}
+	return 0;
+}
@@ -0,0 +1,163 @@
+#include <tools/ToolArgs.h>
+#include <tools/ToolPolicies.h>
+#include <game/PackedSnakeBody.h>
+#include <game/SnakeBody.h>
+#include <game/SnakeGame.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double Seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Cell i of a serpentine walk over rows of width w
+static Cell Serpentine(int64_t i, int w)
+{
+	const int y = int(i / w);
+	const int x = int(i % w);
+	return { (y & 1) ? w - 1 - x : x, y };
+}
+
+// Mirror every step of real games into a packed body; decode must agree
+static int RoundTrip(int games, int w, int h)
+{
+	SnakeGame game(w, h);
+	PackedSnakeBody packed;
+	std::vector<Cell> expect(size_t(w) * size_t(h)), got(expect.size());
+	uint64_t steps = 0;
+	int mismatches = 0;
+
+	for (int g = 0; g < games; ++g)
+	{
+		game.Reset(uint64_t(g) + 1);
+		SnakeRng rng = SnakeRng::ForStream(uint64_t(g) + 1, 1);
+		std::vector<Cell> start(size_t(game.GetLength()));
+		int k = 0;
+		game.GetBody().ForEach([&](const Cell& c) { start[size_t(k++)] = c; });
+		packed.Assign(start.data(), int(start.size()));
+
+		while (!game.IsGameOver())
+		{
+			const int before = game.GetLength();
+			game.SetPendingDir(GreedyPolicy(game, rng));
+			game.Tick();
+			if (game.IsGameOver()) break;
+
+			packed.PushFront(game.GetHead());
+			if (game.GetLength() == before) packed.PopBack();
+			++steps;
+
+			const int n = game.GetLength();
+			k = 0;
+			game.GetBody().ForEach([&](const Cell& c) { expect[size_t(k++)] = c; });
+			packed.Decode(got.data());
+			const bool same = packed.Size() == n && packed.Back().x == expect[size_t(n) - 1].x &&
+				packed.Back().y == expect[size_t(n) - 1].y && std::memcmp(got.data(), expect.data(), sizeof(Cell) * size_t(n)) == 0;
+			mismatches += !same;
+		}
+	}
+
+	std::cout << "  round trip: " << games << " games on " << w << "x" << h << ", " << steps
+		<< " steps mirrored, decode " << (mismatches ? "MISMATCH " : "matches SnakeGame ") << mismatches << "\n";
+	return mismatches;
+}
+
+int BenchPacked(const ToolArgs& args)
+{
+	const int games = int(args.GetInt("--games", 2000));
+	const int w = int(args.GetInt("--grid-w", 32));
+	const int h = int(args.GetInt("--grid-h", 18));
+	const int ops = int(args.GetInt("--ops", 20000000));
+
+	std::cout << "bench-packed:\n" << std::fixed;
+	const int failures = RoundTrip(games, w, h);
+
+	// Bytes per body at the exact length, container included
+	std::cout << "  memory per body (SnakeBody vs PackedSnakeBody):\n";
+	for (int length = 16; length <= (1 << 20); length *= 8)
+	{
+		SnakeBody body;
+		body.Init(length);
+		PackedSnakeBody packed;
+		packed.Init(length);
+		for (int i = 0; i < length; ++i)
+		{
+			body.PushFront(Serpentine(i, 1024));
+			packed.PushFront(Serpentine(i, 1024));
+		}
+
+		const double plain = double(sizeof(SnakeBody) + size_t(body.Capacity()) * sizeof(Cell));
+		const double small = double(packed.GetMemoryBytes());
+		std::cout << "    length " << std::setw(7) << length << ": " << std::setw(9) << std::setprecision(0) << plain
+			<< " vs " << std::setw(7) << small << " bytes (" << std::setprecision(1) << plain / small
+			<< "x), 1M such bodies " << std::setprecision(2) << plain * 1e6 / 1e9 << " GB vs " << small * 1e6 / 1e9 << " GB\n";
+	}
+
+	// Moving a length-1024 snake: push + pop per step
+	{
+		const int length = 1024;
+		SnakeBody body;
+		body.Init(length + 1);
+		PackedSnakeBody packed;
+		packed.Init(length + 1);
+		for (int i = 0; i < length; ++i)
+		{
+			body.PushFront(Serpentine(i, 1024));
+			packed.PushFront(Serpentine(i, 1024));
+		}
+
+		auto start = Clock::now();
+		for (int i = 0; i < ops; ++i)
+		{
+			body.PushFront(Serpentine(length + i, 1024));
+			body.PopBack();
+		}
+		const double plainSec = Seconds(start);
+
+		start = Clock::now();
+		for (int i = 0; i < ops; ++i)
+		{
+			packed.PushFront(Serpentine(length + i, 1024));
+			packed.PopBack();
+		}
+		const double packedSec = Seconds(start);
+		const bool same = body.Back().x == packed.Back().x && body.Back().y == packed.Back().y;
+
+		std::cout << "  move (push + pop), length " << length << ": SnakeBody " << std::setprecision(1)
+			<< ops / plainSec / 1e6 << " M/s, packed " << ops / packedSec / 1e6 << " M/s, tails "
+			<< (same ? "agree" : "DIFFER") << "\n";
+
+		// Decode to cells for rendering, against a plain copy
+		const size_t cellCount = size_t(length);
+		std::vector<Cell> out(cellCount);
+		const int reps = std::max(1, ops / length);
+		start = Clock::now();
+		for (int r = 0; r < reps; ++r) body.CopyTo(out.data());
+		const double copySec = Seconds(start);
+
+		start = Clock::now();
+		for (int r = 0; r < reps; ++r) packed.Decode(out.data());
+		const double decodeSec = Seconds(start);
+
+		int64_t sink = 0;
+		start = Clock::now();
+		for (int r = 0; r < reps; ++r) packed.ForEach([&](const Cell& c) { sink += c.x; });
+		const double eachSec = Seconds(start);
+
+		const double cells = double(reps) * double(length);
+		std::cout << "  decode, length " << length << ": SnakeBody::CopyTo " << std::setprecision(0) << cells / copySec / 1e6
+			<< " M cells/s, Decode " << cells / decodeSec / 1e6 << " M cells/s, ForEach " << cells / eachSec / 1e6
+			<< " M cells/s (checksum " << (sink & 0xFFFF) << ")\n";
+	}
+
+	return failures ? 1 : 0;
+}
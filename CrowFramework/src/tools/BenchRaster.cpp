@@ -0,0 +1,90 @@
+#include <tools/ToolArgs.h>
+#include <engine/WorkStealingPool.h>
+#include <game/SnakeBatch.h>
+#include <game/SnakeRaster.h>
+#include <game/SnakeRng.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double TimeRenders(const SnakeRaster& raster, const SnakeBatch& batch, uint8_t* images,
+	WorkStealingPool* pool, int rounds)
+{
+	auto start = Clock::now();
+	for (int r = 0; r < rounds; ++r)
+		raster.RenderAll(batch, images, pool);
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+int BenchRaster(const ToolArgs& args)
+{
+	const int games = int(args.GetInt("--games", 4096));
+	const int rounds = int(args.GetInt("--rounds", 20));
+	const int w = int(args.GetInt("--grid-w", 32));
+	const int h = int(args.GetInt("--grid-h", 18));
+	const int outW = int(args.GetInt("--out-w", 84));
+	const int outH = int(args.GetInt("--out-h", 84));
+	const int maxThreads = int(args.GetInt("--threads", WorkStealingPool::HardwareThreads()));
+
+	// Mid-game boards: random walks, restarted when they die
+	const size_t n = size_t(games);
+	SnakeBatch batch(games, w, h);
+	std::vector<uint64_t> seeds(n);
+	for (int i = 0; i < games; ++i)
+		seeds[size_t(i)] = uint64_t(i) + 1;
+	batch.ResetAll(seeds.data());
+
+	SnakeRng rng(3);
+	std::vector<Dir> actions(n);
+	std::vector<uint8_t> done(n);
+	for (int s = 0; s < 200; ++s)
+	{
+		for (Dir& a : actions)
+			a = Dir(rng.NextBelow(4));
+		batch.Step(actions.data(), done.data(), nullptr);
+		for (int i = 0; i < games; ++i)
+			if (done[size_t(i)] && s < 150) batch.Reset(i, seeds[size_t(i)] + 1000000);
+	}
+
+	SnakeRaster raster(w, h, outW, outH);
+	const size_t bytes = n * raster.GetImageSize();
+	std::vector<uint8_t> scalarImages(bytes), images(bytes);
+
+	std::cout << "bench-raster: " << games << " games on " << w << "x" << h << " -> " << outW << "x" << outH
+		<< " uint8, " << rounds << " rounds, " << bytes / 1024 << " KB per batch\n" << std::fixed;
+
+	raster.SetKernel(SnakeRasterKernel::Scalar);
+	const double scalarSec = TimeRenders(raster, batch, scalarImages.data(), nullptr, rounds);
+	std::cout << "  scalar, 1 thread: " << std::setprecision(2) << double(games) * rounds / scalarSec / 1e6 << " M images/s\n";
+
+	raster.SetKernel(SnakeRasterKernel::Auto);
+	if (raster.GetKernel() != SnakeRasterKernel::Avx2)
+	{
+		std::cout << "  AVX2 kernel unavailable (CPU or scale), scalar only\n";
+		return 0;
+	}
+
+	const double simdSec = TimeRenders(raster, batch, images.data(), nullptr, rounds);
+	const bool same = std::memcmp(images.data(), scalarImages.data(), bytes) == 0;
+	std::cout << "  avx2,   1 thread: " << double(games) * rounds / simdSec / 1e6 << " M images/s ("
+		<< scalarSec / simdSec << "x scalar), output " << (same ? "matches scalar" : "DIFFERS from scalar") << "\n";
+
+	for (int threads = 2; threads <= maxThreads; threads *= 2)
+	{
+		WorkStealingPool pool(threads);
+		const double sec = TimeRenders(raster, batch, images.data(), &pool, rounds);
+		std::cout << "  avx2, " << std::setw(2) << threads << " threads: " << double(games) * rounds / sec / 1e6
+			<< " M images/s (" << simdSec / sec << "x)\n";
+	}
+
+	if (maxThreads < 2)
+		std::cout << "  (one hardware thread: no scaling run, pass --threads N to force one)\n";
+
+	return same ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+#include <tools/ToolArgs.h>
+#include <engine/WorkStealingPool.h>
+#include <game/SnakeRunner.h>
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// Greedy baseline: head toward the food, never into an occupied cell
+static Dir GreedyPolicy(const SnakeGame& game, SnakeRng&, int)
+{
+	const Cell head = game.GetHead();
+	const Cell food = game.GetFood();
+
+	Dir order[4];
+	int n = 0;
+	if (food.x > head.x) order[n++] = Dir::Right;
+	if (food.x < head.x) order[n++] = Dir::Left;
+	if (food.y > head.y) order[n++] = Dir::Down;
+	if (food.y < head.y) order[n++] = Dir::Up;
+	for (Dir d : { Dir::Up, Dir::Right, Dir::Down, Dir::Left })
+	{
+		bool listed = false;
+		for (int i = 0; i < n; ++i) listed |= order[i] == d;
+		if (!listed) order[n++] = d;
+	}
+
+	for (Dir d : order)
+		if (!game.IsBlocked(Neighbor(head, d)))
+			return d;
+
+	return game.GetDir();
+}
+
+static void PrintStats(const RunnerStats& s)
+{
+	std::cout << "  episodes " << s.episodes << ", steps " << s.steps
+		<< ", score mean " << std::fixed << std::setprecision(2) << s.MeanScore()
+		<< " min " << s.scoreMin << " max " << s.scoreMax
+		<< ", mean length " << (s.episodes ? double(s.lengthSum) / double(s.episodes) : 0.0) << "\n"
+		<< "  ends: wall " << s.ends[int(EpisodeEnd::Wall)]
+		<< ", self " << s.ends[int(EpisodeEnd::Self)]
+		<< ", won " << s.ends[int(EpisodeEnd::Won)]
+		<< ", starved " << s.ends[int(EpisodeEnd::Starved)] << "\n";
+}
+
+int BenchRunner(const ToolArgs& args)
+{
+	RunnerConfig config;
+	config.gridW = int(args.GetInt("--grid-w", 32));
+	config.gridH = int(args.GetInt("--grid-h", 18));
+	config.seedBegin = uint64_t(args.GetInt("--seed", 0));
+	config.seedEnd = config.seedBegin + uint64_t(args.GetInt("--episodes", 200000));
+	const int maxThreads = int(args.GetInt("--threads", WorkStealingPool::HardwareThreads()));
+
+	std::cout << "bench-runner: " << (config.seedEnd - config.seedBegin) << " greedy episodes on "
+		<< config.gridW << "x" << config.gridH << "\n";
+
+	// Speedup curve: 1, 2, 4, ... threads, plus the maximum
+	std::vector<int> counts;
+	for (int t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+	counts.push_back(maxThreads);
+
+	double baseRate = 0.0;
+	for (int threads : counts)
+	{
+		WorkStealingPool pool(threads);
+		RunnerStats stats = RunEpisodes(pool, config, &GreedyPolicy);
+
+		const double rate = double(stats.episodes) / stats.seconds;
+		if (baseRate == 0.0) baseRate = rate;
+
+		std::cout << std::setw(4) << threads << " threads: "
+			<< std::fixed << std::setprecision(0) << std::setw(10) << rate << " episodes/s, "
+			<< std::setprecision(1) << double(stats.steps) / stats.seconds / 1e6 << " M steps/s, speedup "
+			<< std::setprecision(2) << rate / baseRate << "x (efficiency "
+			<< std::setprecision(0) << 100.0 * rate / baseRate / threads << "%)\n";
+
+		if (threads == counts.back())
+			PrintStats(stats);
+	}
+	return 0;
+}
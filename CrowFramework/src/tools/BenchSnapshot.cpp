@@ -0,0 +1,123 @@
+#include <tools/ToolArgs.h>
+#include <game/SnakeGame.h>
+#include <game/SnakeSnapshot.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double Seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Greedy toward food, never into a blocked cell, until the snake reaches
+// the target length; seeds that die first are skipped
+static void PlayInto(SnakeGame& game, int length, SnakeRng& rng)
+{
+	for (int s = 0; s < 1000000 && game.GetLength() < length; ++s)
+	{
+		if (game.IsGameOver()) game.Reset(game.GetSeed() + 1);
+
+		const Cell h = game.GetHead();
+		const Cell f = game.GetFood();
+		const Cell next[4] = { { h.x, h.y - 1 }, { h.x, h.y + 1 }, { h.x - 1, h.y }, { h.x + 1, h.y } };
+
+		int best = -1, bestCost = 1 << 30;
+		for (int d = 0; d < 4; ++d)
+		{
+			if (game.IsBlocked(next[d])) continue;
+			const int cost = (std::abs(next[d].x - f.x) + std::abs(next[d].y - f.y)) * 4 + int(rng.NextBelow(4));
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				best = d;
+			}
+		}
+		game.SetPendingDir(best < 0 ? game.GetDir() : Dir(best));
+		game.Tick();
+	}
+}
+
+// Depth-first walk over every move sequence up to depth, restoring from the
+// arena between siblings. Returns the number of nodes visited.
+static uint64_t Search(SnakeGame& game, SnakeSnapshotArena& arena, int depth)
+{
+	if (depth == 0 || game.IsGameOver()) return 1;
+
+	uint64_t nodes = 1;
+	arena.Push(game);
+	for (int d = 0; d < 4; ++d)
+	{
+		if (d) arena.RestoreTop(game);
+		game.SetPendingDir(Dir(d));
+		game.Tick();
+		nodes += Search(game, arena, depth - 1);
+	}
+	arena.Pop(game);
+	return nodes;
+}
+
+int BenchSnapshot(const ToolArgs& args)
+{
+	const int w = int(args.GetInt("--grid-w", 32));
+	const int h = int(args.GetInt("--grid-h", 18));
+	const int iters = int(args.GetInt("--iters", 200000));
+	const int depth = int(args.GetInt("--depth", 9));
+
+	SnakeGame game(w, h, uint64_t(args.GetInt("--seed", 1)));
+	SnakeRng rng(7);
+	PlayInto(game, int(args.GetInt("--length", 60)), rng);
+
+	std::cout << "bench-snapshot: " << w << "x" << h << ", length " << game.GetLength()
+		<< ", slot " << game.GetSnapshotSize() << " bytes\n";
+
+	// Baseline: clone by copy construction (vectors reallocate every time)
+	auto start = Clock::now();
+	uint64_t sink = 0;
+	for (int i = 0; i < iters; ++i)
+	{
+		SnakeGame copy(game);
+		sink += uint64_t(copy.GetLength());
+	}
+	const double copySec = Seconds(start);
+
+	SnakeSnapshotArena arena(game, depth + 1);
+	SnakeGame scratch(w, h);
+	start = Clock::now();
+	for (int i = 0; i < iters; ++i)
+	{
+		arena.Push(game);
+		arena.Pop(scratch);
+		sink += uint64_t(scratch.GetLength());
+	}
+	const double snapSec = Seconds(start);
+
+	std::cout << std::fixed << std::setprecision(1)
+		<< "  copy-construct       " << std::setw(8) << copySec / iters * 1e9 << " ns/clone\n"
+		<< "  save + restore       " << std::setw(8) << snapSec / iters * 1e9 << " ns/clone  ("
+		<< std::setprecision(2) << copySec / snapSec << "x)\n";
+
+	// Search: full 4-ary tree, then the root must come back bit-identical
+	std::vector<unsigned char> before(game.GetSnapshotSize()), after(game.GetSnapshotSize());
+	game.Save(before.data());
+
+	start = Clock::now();
+	const uint64_t nodes = Search(game, arena, depth);
+	const double searchSec = Seconds(start);
+
+	game.Save(after.data());
+	const bool same = std::memcmp(before.data(), after.data(), before.size()) == 0;
+
+	std::cout << std::setprecision(1) << "  depth-" << depth << " search     " << std::setw(8)
+		<< double(nodes) / searchSec / 1e6 << " M nodes/s (" << nodes << " nodes), root "
+		<< (same ? "restored exactly" : "CHANGED") << "\n";
+
+	return (same && sink) ? 0 : 1;
+}
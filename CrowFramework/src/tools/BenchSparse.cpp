@@ -0,0 +1,114 @@
+#include <tools/ToolArgs.h>
+#include <tools/ToolPolicies.h>
+#include <game/SnakeGame.h>
+#include <game/SparseSnakeGame.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <unordered_set>
+
+using Clock = std::chrono::steady_clock;
+
+static double Seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct RunStats
+{
+	double stepsPerSec = 0.0;
+	int games = 0;
+	int bestLength = 0;
+};
+
+// Drive the greedy policy for `steps` ticks, resetting on death
+template <typename Game>
+static RunStats Run(Game& game, uint64_t steps)
+{
+	SnakeRng rng(7);
+	RunStats stats;
+	stats.games = 1;
+
+	auto start = Clock::now();
+	for (uint64_t s = 0; s < steps; ++s)
+	{
+		if (game.IsGameOver())
+		{
+			game.Reset(game.GetSeed() + 1);
+			stats.games++;
+		}
+		game.SetPendingDir(GreedyPolicy(game, rng));
+		game.Tick();
+		if (game.GetLength() > stats.bestLength) stats.bestLength = game.GetLength();
+	}
+	stats.stepsPerSec = double(steps) / Seconds(start);
+	return stats;
+}
+
+// Every body cell blocked, and one live tile per 64x64 block the body touches
+static bool CheckTiles(const SparseSnakeGame& game)
+{
+	std::unordered_set<uint64_t> blocks;
+	bool blocked = true;
+	game.GetBody().ForEach([&](const Cell& c)
+		{
+			blocked = blocked && game.IsBlocked(c);
+			blocks.insert(uint64_t(c.y >> SparseSnakeGame::kTileShift) << 32 | uint64_t(c.x >> SparseSnakeGame::kTileShift));
+		});
+	if (!blocked) return false;
+	return int(blocks.size()) == game.GetTileCount();
+}
+
+// SnakeGame per cell: occupancy byte, free list + position, 4 Zobrist keys,
+// plus a body ring sized for the whole board
+static double DenseBytes(int w, int h)
+{
+	const uint64_t cells = uint64_t(w) * uint64_t(h);
+	uint64_t ring = 1;
+	while (ring < cells) ring <<= 1;
+	return double(cells * (1 + 4 + 4 + 4 * 8) + ring * sizeof(Cell));
+}
+
+int BenchSparse(const ToolArgs& args)
+{
+	const uint64_t steps = uint64_t(args.GetInt("--steps", 2000000));
+	const int maxSize = int(std::min<long long>(args.GetInt("--max-size", 16384), SparseSnakeGame::kMaxSide));
+	const int denseMax = int(args.GetInt("--dense-max", 1024));
+
+	std::cout << "bench-sparse: " << steps << " greedy steps per board\n" << std::fixed;
+
+	bool ok = true;
+	for (int size = 256; size <= maxSize; size *= 4)
+	{
+		SparseSnakeGame sparse(size, size, 1);
+		const RunStats s = Run(sparse, steps);
+		const bool tilesOk = CheckTiles(sparse);
+		ok = ok && tilesOk;
+
+		const double mb = 1024.0 * 1024.0;
+		std::cout << "  " << std::setw(5) << size << "x" << std::setw(5) << std::left << size << std::right
+			<< "  sparse " << std::setprecision(1) << std::setw(5) << s.stepsPerSec / 1e6 << " M steps/s, "
+			<< s.games << " games, best length " << s.bestLength << ", " << sparse.GetTileCount() << " tiles, "
+			<< std::setprecision(2) << double(sparse.GetMemoryBytes()) / mb << " MB"
+			<< (tilesOk ? "" : " TILE MISMATCH") << "\n";
+
+		// The dense game allocates per cell up front
+		if (size <= denseMax)
+		{
+			SnakeGame dense(size, size, 1);
+			const RunStats d = Run(dense, steps);
+			std::cout << "               dense  " << std::setprecision(1) << std::setw(5) << d.stepsPerSec / 1e6
+				<< " M steps/s, " << d.games << " games, best length " << d.bestLength << ", ~"
+				<< std::setprecision(2) << DenseBytes(size, size) / mb << " MB\n";
+		}
+		else
+			std::cout << "               dense  not run, would need ~" << std::setprecision(0)
+				<< DenseBytes(size, size) / mb << " MB\n";
+	}
+
+	return ok ? 0 : 1;
+}
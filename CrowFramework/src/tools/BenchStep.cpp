@@ -0,0 +1,240 @@
+#include <tools/ToolArgs.h>
+#include <game/SnakeGame.h>
+#include <game/BitboardSnakeGame.h>
+#include <game/FixedSnakeGame.h>
+#include <game/SnakeBatch.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Cheap deterministic policy shared by all engines: keep going, turn at
+// walls, random perpendicular turn 1 step in 16. Never reverses, so the
+// committed direction always equals the last one issued.
+static Dir BenchPolicy(Cell head, Dir dir, int w, int h, uint32_t& rng)
+{
+	rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+
+	const bool vertical = dir == Dir::Up || dir == Dir::Down;
+	if ((rng & 15) == 0)
+		dir = vertical ? ((rng & 16) ? Dir::Left : Dir::Right) : ((rng & 16) ? Dir::Up : Dir::Down);
+
+	switch (dir)
+	{
+	case Dir::Up:    if (head.y == 0)     dir = head.x > w / 2 ? Dir::Left : Dir::Right; break;
+	case Dir::Down:  if (head.y == h - 1) dir = head.x > w / 2 ? Dir::Left : Dir::Right; break;
+	case Dir::Left:  if (head.x == 0)     dir = head.y > h / 2 ? Dir::Up : Dir::Down; break;
+	case Dir::Right: if (head.x == w - 1) dir = head.y > h / 2 ? Dir::Up : Dir::Down; break;
+	}
+	return dir;
+}
+
+using Clock = std::chrono::steady_clock;
+
+static double Seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static void Report(const char* name, long long gameSteps, double seconds, double baseline)
+{
+	const double rate = double(gameSteps) / seconds;
+	std::cout << std::left << std::setw(28) << name
+		<< std::right << std::setw(14) << std::fixed << std::setprecision(1) << rate / 1e6 << " M steps/s"
+		<< std::setw(9) << std::setprecision(2) << (baseline > 0.0 ? rate / baseline : 1.0) << "x\n";
+}
+
+// Object-per-game engines (SnakeGame API): one Update(stepTime) = one step
+template <typename Game, typename MakeFn>
+static double RunObjects(const char* name, int games, int steps, int w, int h, MakeFn make, double baseline)
+{
+	std::vector<std::unique_ptr<Game>> pool;
+	std::vector<Dir> dirs(size_t(games), Dir::Right);
+	std::vector<uint32_t> rng(static_cast<size_t>(games));
+	for (int i = 0; i < games; ++i)
+	{
+		pool.push_back(make());
+		rng[i] = 0x9E3779B9u * uint32_t(i + 1);
+	}
+
+	auto start = Clock::now();
+	for (int s = 0; s < steps; ++s)
+	{
+		for (int i = 0; i < games; ++i)
+		{
+			Game& g = *pool[i];
+			if (g.IsGameOver())
+			{
+				g.Reset();
+				dirs[i] = Dir::Right;
+			}
+			dirs[i] = BenchPolicy(g.GetHead(), dirs[i], w, h, rng[i]);
+			g.SetPendingDir(dirs[i]);
+			g.Update(0.2f);
+		}
+	}
+	const double sec = Seconds(start);
+
+	Report(name, (long long)games * steps, sec, baseline);
+	return double(games) * steps / sec;
+}
+
+static void RunBatch(const char* name, SnakeBatchKernel kernel, int games, int steps, int w, int h, double baseline)
+{
+	SnakeBatch batch(games, w, h);
+	batch.SetKernel(kernel);
+	if (kernel != SnakeBatchKernel::Scalar && batch.GetKernel() != kernel)
+	{
+		std::cout << std::left << std::setw(28) << name << "  (not supported on this CPU)\n";
+		return;
+	}
+
+	std::vector<Dir> actions(size_t(games), Dir::Right);
+	std::vector<uint8_t> done(size_t(games), 0);
+	std::vector<uint32_t> rng(static_cast<size_t>(games));
+	for (int i = 0; i < games; ++i)
+		rng[i] = 0x9E3779B9u * uint32_t(i + 1);
+
+	const int32_t* hx = batch.GetHeadXs();
+	const int32_t* hy = batch.GetHeadYs();
+
+	auto start = Clock::now();
+	for (int s = 0; s < steps; ++s)
+	{
+		for (int i = 0; i < games; ++i)
+		{
+			if (done[i])
+			{
+				batch.Reset(i, rng[i]);
+				actions[i] = Dir::Right;
+			}
+			actions[i] = BenchPolicy({ hx[i], hy[i] }, actions[i], w, h, rng[i]);
+		}
+		batch.Step(actions.data(), done.data(), nullptr);
+	}
+	const double sec = Seconds(start);
+
+	Report(name, (long long)games * steps, sec, baseline);
+}
+
+// Same inputs into SnakeBatch (scalar and AVX2 plan kernels) and one
+// reference SnakeGame per slot; every step must agree on outcome, reward,
+// head, length, direction and food, and every 64 steps on the whole body.
+// Returns the number of disagreeing (step, game) pairs
+static long long CrossCheck(int games, int steps, int w, int h)
+{
+	SnakeBatch scalar(games, w, h), simd(games, w, h);
+	scalar.SetKernel(SnakeBatchKernel::Scalar);
+	simd.SetKernel(SnakeBatchKernel::Avx2);
+	const bool hasSimd = simd.GetKernel() == SnakeBatchKernel::Avx2;
+
+	std::vector<std::unique_ptr<SnakeGame>> refs;
+	std::vector<Dir> actions(size_t(games), Dir::Right);
+	std::vector<uint8_t> done(size_t(games), 0), simdDone(size_t(games), 0);
+	std::vector<float> rewards(size_t(games), 0.0f), simdRewards(size_t(games), 0.0f);
+	std::vector<uint32_t> rng(static_cast<size_t>(games));
+	uint64_t nextSeed = 1;
+	for (int i = 0; i < games; ++i)
+	{
+		refs.push_back(std::make_unique<SnakeGame>(w, h, nextSeed));
+		scalar.Reset(i, nextSeed);
+		simd.Reset(i, nextSeed);
+		++nextSeed;
+		rng[i] = 0x9E3779B9u * uint32_t(i + 1);
+	}
+
+	auto sameBody = [](const SnakeGame& g, const SnakeBatch& b, int i)
+		{
+			std::vector<Cell> a, c;
+			g.GetBody().ForEach([&](const Cell& x) { a.push_back(x); });
+			b.GetBody(i).ForEach([&](const Cell& x) { c.push_back(x); });
+			if (a.size() != c.size()) return false;
+			for (size_t k = 0; k < a.size(); ++k)
+				if (a[k].x != c[k].x || a[k].y != c[k].y) return false;
+			return true;
+		};
+
+	long long mismatches = 0;
+	for (int s = 0; s < steps; ++s)
+	{
+		for (int i = 0; i < games; ++i)
+		{
+			// Mostly the bench policy; now and then any direction, so
+			// self-hits and refused reversals are covered too
+			actions[i] = BenchPolicy(refs[i]->GetHead(), actions[i], w, h, rng[i]);
+			if ((rng[i] >> 8 & 31) == 0) actions[i] = Dir(rng[i] >> 13 & 3);
+		}
+
+		scalar.Step(actions.data(), done.data(), rewards.data());
+		if (hasSimd) simd.Step(actions.data(), simdDone.data(), simdRewards.data());
+
+		for (int i = 0; i < games; ++i)
+		{
+			SnakeGame& g = *refs[i];
+			const int before = g.GetLength();
+			g.SetPendingDir(actions[i]);
+			g.Tick();
+			const float reward = g.IsGameOver() && !g.IsWon() ? -1.0f : (g.GetLength() != before ? 1.0f : 0.0f);
+
+			auto agrees = [&](const SnakeBatch& b, const std::vector<uint8_t>& d, const std::vector<float>& r)
+				{
+					const Cell head = b.GetHead(i), food = b.GetFood(i);
+					const bool over = g.IsGameOver();
+					// Food and head are only defined while the game runs
+					return (d[i] != 0) == over && r[i] == reward && b.GetLength(i) == g.GetLength() &&
+						b.IsWon(i) == g.IsWon() && b.GetDir(i) == g.GetDir() &&
+						(over || (head.x == g.GetHead().x && head.y == g.GetHead().y &&
+							food.x == g.GetFood().x && food.y == g.GetFood().y)) &&
+						((s & 63) != 0 || sameBody(g, b, i));
+				};
+
+			const bool ok = agrees(scalar, done, rewards) && (!hasSimd || agrees(simd, simdDone, simdRewards));
+			mismatches += !ok;
+
+			if (g.IsGameOver())
+			{
+				g.Reset(nextSeed);
+				scalar.Reset(i, nextSeed);
+				simd.Reset(i, nextSeed);
+				++nextSeed;
+				actions[i] = Dir::Right;
+			}
+		}
+	}
+
+	std::cout << "cross-check: " << games << " games x " << steps << " steps, " << nextSeed - 1 << " seeds, SnakeBatch scalar"
+		<< (hasSimd ? " and AVX2" : " (AVX2 unavailable)") << " vs SnakeGame: "
+		<< (mismatches ? "MISMATCH " : "all match ") << mismatches << "\n";
+	return mismatches;
+}
+
+int BenchStep(const ToolArgs& args)
+{
+	const int games = int(args.GetInt("--games", 4096));
+	const int steps = int(args.GetInt("--steps", 2000));
+	const int w = int(args.GetInt("--grid-w", 32));
+	const int h = int(args.GetInt("--grid-h", 18));
+
+	std::cout << "bench-step: " << games << " games x " << steps << " steps on " << w << "x" << h << "\n";
+
+	const double base = RunObjects<SnakeGame>("SnakeGame (scalar)", games, steps, w, h,
+		[&] { return std::make_unique<SnakeGame>(w, h); }, 0.0);
+
+	if (w <= BitboardSnakeGame::kMaxGridW)
+		RunObjects<BitboardSnakeGame>("BitboardSnakeGame", games, steps, w, h,
+			[&] { return std::make_unique<BitboardSnakeGame>(w, h); }, base);
+
+	if (w == 32 && h == 18)
+		RunObjects<FixedSnakeGame<32, 18>>("FixedSnakeGame<32,18>", games, steps, w, h,
+			[] { return std::make_unique<FixedSnakeGame<32, 18>>(); }, base);
+
+	RunBatch("SnakeBatch (scalar)", SnakeBatchKernel::Scalar, games, steps, w, h, base);
+	RunBatch("SnakeBatch (AVX2)", SnakeBatchKernel::Avx2, games, steps, w, h, base);
+
+	const int checkGames = int(args.GetInt("--check-games", 256));
+	const int checkSteps = int(args.GetInt("--check-steps", 2000));
+	return CrossCheck(checkGames, checkSteps, w, h) ? 1 : 0;
+}
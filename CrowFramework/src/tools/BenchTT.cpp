@@ -0,0 +1,233 @@
+#include <tools/ToolArgs.h>
+#include <engine/WorkStealingPool.h>
+#include <game/SnakeGame.h>
+#include <game/SnakeSnapshot.h>
+#include <game/TranspositionTable.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double Seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Greedy toward food until the snake reaches the target length
+static void PlayInto(SnakeGame& game, int length, SnakeRng& rng)
+{
+	for (int s = 0; s < 1000000 && game.GetLength() < length; ++s)
+	{
+		if (game.IsGameOver()) game.Reset(game.GetSeed() + 1);
+
+		const Cell h = game.GetHead();
+		const Cell f = game.GetFood();
+		const Cell next[4] = { { h.x, h.y - 1 }, { h.x, h.y + 1 }, { h.x - 1, h.y }, { h.x + 1, h.y } };
+
+		int best = -1, bestCost = 1 << 30;
+		for (int d = 0; d < 4; ++d)
+		{
+			if (game.IsBlocked(next[d])) continue;
+			const int cost = (std::abs(next[d].x - f.x) + std::abs(next[d].y - f.y)) * 4 + int(rng.NextBelow(4));
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				best = d;
+			}
+		}
+		game.SetPendingDir(best < 0 ? game.GetDir() : Dir(best));
+		game.Tick();
+	}
+}
+
+struct SearchContext
+{
+	SnakeSnapshotArena* arena;
+	TranspositionTable* table; // nullptr = plain DFS
+	uint64_t nodes = 0;
+	uint64_t hits = 0;
+};
+
+// Longest snake reachable within depth steps (dead = 0). The hash ignores
+// the RNG, so after a meal two transposed lines may differ in the next food:
+// fine for a benchmark value, not an exact solver.
+static int Search(SnakeGame& game, SearchContext& ctx, int depth)
+{
+	ctx.nodes++;
+	if (game.IsGameOver()) return game.IsWon() ? game.GetLength() : 0;
+	if (depth == 0) return game.GetLength();
+
+	TTEntry hit;
+	if (ctx.table && ctx.table->Probe(game.GetHash(), hit) && hit.depth >= depth)
+	{
+		ctx.hits++;
+		return hit.value;
+	}
+
+	int best = 0;
+	uint8_t bestMove = 0;
+	const int dir = int(game.GetDir());
+	bool first = true;
+	ctx.arena->Push(game);
+	for (int d = 0; d < 4; ++d)
+	{
+		// Reversal = keep going straight, already covered by that sibling
+		if ((d ^ dir) == 1) continue;
+		if (!first) ctx.arena->RestoreTop(game);
+		first = false;
+
+		game.SetPendingDir(Dir(d));
+		game.Tick();
+		const int v = Search(game, ctx, depth - 1);
+		if (v > best)
+		{
+			best = v;
+			bestMove = uint8_t(d);
+		}
+	}
+	ctx.arena->Pop(game);
+
+	if (ctx.table)
+	{
+		TTEntry e;
+		e.value = best;
+		e.depth = int16_t(depth);
+		e.move = bestMove;
+		ctx.table->Store(game.GetHash(), e);
+	}
+	return best;
+}
+
+// Incremental hash must equal the from-scratch hash at every step
+static bool CheckHashes(int w, int h, int games)
+{
+	for (int g = 0; g < games; ++g)
+	{
+		SnakeGame game(w, h, uint64_t(g));
+		SnakeRng rng(uint64_t(g) + 1000);
+		while (!game.IsGameOver())
+		{
+			if (game.GetHash() != game.ComputeHash()) return false;
+			const Cell head = game.GetHead();
+			const Dir d = Dir(rng.NextBelow(4));
+			const Cell next[4] = { { head.x, head.y - 1 }, { head.x, head.y + 1 }, { head.x - 1, head.y }, { head.x + 1, head.y } };
+			game.SetPendingDir(game.IsBlocked(next[int(d)]) && rng.NextBelow(8) ? game.GetDir() : d);
+			game.Tick();
+		}
+		if (game.GetHash() != game.ComputeHash()) return false;
+	}
+	return true;
+}
+
+int BenchTT(const ToolArgs& args)
+{
+	const int w = int(args.GetInt("--grid-w", 12));
+	const int h = int(args.GetInt("--grid-h", 10));
+	const int depth = int(args.GetInt("--depth", 14));
+	const int threads = int(args.GetInt("--threads", WorkStealingPool::HardwareThreads()));
+	const int sizeLog2 = int(args.GetInt("--tt-log2", 20));
+
+	const bool hashesOk = CheckHashes(w, h, 200);
+	std::cout << "bench-tt: " << w << "x" << h << ", depth " << depth << ", table 2^" << sizeLog2
+		<< " slots\n  incremental hash == recomputed hash over 200 games: " << (hashesOk ? "yes" : "NO") << "\n";
+
+	// Lines transpose once the search runs deeper than the snake is long
+	// (older moves fall off the tail), so the default root is a short snake
+	SnakeGame root(w, h, uint64_t(args.GetInt("--seed", 1)));
+	SnakeRng rng(7);
+	PlayInto(root, int(args.GetInt("--length", 6)), rng);
+
+	std::cout << std::fixed;
+	int plainValue = 0;
+	{
+		SnakeGame game = root;
+		SnakeSnapshotArena arena(game, depth + 1);
+		SearchContext ctx{ &arena, nullptr };
+
+		auto start = Clock::now();
+		plainValue = Search(game, ctx, depth);
+		const double sec = Seconds(start);
+		std::cout << "  plain DFS        " << std::setw(12) << ctx.nodes << " nodes  "
+			<< std::setprecision(1) << std::setw(8) << sec * 1e3 << " ms  value " << plainValue << "\n";
+	}
+
+	TranspositionTable table(sizeLog2);
+	{
+		SnakeGame game = root;
+		SnakeSnapshotArena arena(game, depth + 1);
+		SearchContext ctx{ &arena, &table };
+
+		auto start = Clock::now();
+		const int value = Search(game, ctx, depth);
+		const double sec = Seconds(start);
+		std::cout << "  DFS + TT         " << std::setw(12) << ctx.nodes << " nodes  "
+			<< std::setw(8) << sec * 1e3 << " ms  value " << value << ", "
+			<< std::setprecision(1) << 100.0 * double(ctx.hits) / double(ctx.nodes) << "% hits\n";
+	}
+
+	// Shared table: split the first two plies (16 lines) across the pool
+	{
+		table.Clear();
+		WorkStealingPool pool(threads);
+
+		struct alignas(64) WorkerState
+		{
+			std::unique_ptr<SnakeGame> game;
+			std::unique_ptr<SnakeSnapshotArena> arena;
+			uint64_t nodes = 0;
+			uint64_t hits = 0;
+			int best = 0;
+		};
+		std::vector<WorkerState> state(static_cast<size_t>(threads));
+		for (WorkerState& s : state)
+		{
+			s.game = std::make_unique<SnakeGame>(root);
+			s.arena = std::make_unique<SnakeSnapshotArena>(root, depth + 1);
+		}
+
+		std::vector<unsigned char> rootSlot(root.GetSnapshotSize());
+		root.Save(rootSlot.data());
+
+		auto start = Clock::now();
+		pool.ParallelFor(0, 16, 1, [&](int64_t begin, int64_t end, int worker)
+			{
+				WorkerState& s = state[worker];
+				SearchContext ctx{ s.arena.get(), &table };
+				for (int64_t line = begin; line < end; ++line)
+				{
+					s.game->Restore(rootSlot.data());
+					for (int ply = 0; ply < 2 && !s.game->IsGameOver(); ++ply)
+					{
+						s.game->SetPendingDir(Dir(ply ? line & 3 : line >> 2));
+						s.game->Tick();
+					}
+					s.best = std::max(s.best, Search(*s.game, ctx, depth - 2));
+				}
+				s.nodes += ctx.nodes;
+				s.hits += ctx.hits;
+			});
+		const double sec = Seconds(start);
+
+		uint64_t nodes = 0, hits = 0;
+		int value = 0;
+		for (const WorkerState& s : state)
+		{
+			nodes += s.nodes;
+			hits += s.hits;
+			value = std::max(value, s.best);
+		}
+		std::cout << "  " << std::setw(2) << threads << " threads + TT   " << std::setw(12) << nodes << " nodes  "
+			<< std::setw(8) << sec * 1e3 << " ms  value " << value << ", "
+			<< std::setprecision(1) << 100.0 * double(hits) / double(nodes) << "% hits\n";
+	}
+
+	return hashesOk ? 0 : 1;
+}
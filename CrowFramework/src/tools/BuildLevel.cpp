@@ -0,0 +1,193 @@
+#include <tools/ToolArgs.h>
+#include <tools/ToolPolicies.h>
+#include <engine/WorkStealingPool.h>
+#include <game/LevelMap.h>
+#include <game/SnakeGame.h>
+#include <game/SnakeRunner.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double Seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Random wall rectangles until about density of the board is covered
+static std::vector<uint8_t> RandomWalls(int w, int h, double density, uint64_t seed)
+{
+	const size_t cells = size_t(w) * size_t(h);
+	std::vector<uint8_t> walls(cells, 0);
+	SnakeRng rng(seed);
+
+	const size_t target = size_t(double(cells) * density);
+	const int maxSide = std::max(2, std::min(w, h) / 16);
+	size_t covered = 0;
+	while (covered < target)
+	{
+		const int rw = 1 + int(rng.NextBelow(uint32_t(maxSide)));
+		const int rh = 1 + int(rng.NextBelow(uint32_t(maxSide)));
+		const int x0 = int(rng.NextBelow(uint32_t(w)));
+		const int y0 = int(rng.NextBelow(uint32_t(h)));
+		for (int y = y0; y < std::min(h, y0 + rh); ++y)
+			for (int x = x0; x < std::min(w, x0 + rw); ++x)
+			{
+				uint8_t& c = walls[size_t(y) * size_t(w) + size_t(x)];
+				covered += !c;
+				c = 1;
+			}
+	}
+	return walls;
+}
+
+// Text level: one row per line, '#' = wall, anything else open
+static bool ReadAscii(const char* path, int& w, int& h, std::vector<uint8_t>& walls)
+{
+	FILE* in = std::fopen(path, "r");
+	if (!in) return false;
+
+	std::vector<std::string> rows(1);
+	for (int ch; (ch = std::fgetc(in)) != EOF;)
+	{
+		if (ch == '\n') rows.emplace_back();
+		else if (ch != '\r') rows.back().push_back(char(ch));
+	}
+	std::fclose(in);
+	while (!rows.empty() && rows.back().empty()) rows.pop_back();
+
+	h = int(rows.size());
+	w = 0;
+	for (const std::string& r : rows) w = std::max(w, int(r.size()));
+	walls.assign(size_t(w) * size_t(h), 0);
+	for (int y = 0; y < h; ++y)
+		for (int x = 0; x < int(rows[size_t(y)].size()); ++x)
+			walls[size_t(y) * size_t(w) + size_t(x)] = rows[size_t(y)][size_t(x)] == '#';
+	return h > 0;
+}
+
+int BuildLevel(const ToolArgs& args)
+{
+	const char* file = args.Get("--file", "level.snlv");
+	const char* ascii = args.Get("--ascii", nullptr);
+	int w = int(args.GetInt("--grid-w", 1024));
+	int h = int(args.GetInt("--grid-h", 1024));
+	const double density = args.GetDouble("--density", 0.15);
+	const uint64_t seed = uint64_t(args.GetInt("--seed", 1));
+	const int episodes = int(args.GetInt("--episodes", 64));
+	const int threads = int(args.GetInt("--threads", 0));
+	const int queries = int(args.GetInt("--queries", 20000000));
+
+	std::cout << "build-level:\n" << std::fixed;
+
+	std::vector<uint8_t> walls;
+	if (ascii)
+	{
+		if (!ReadAscii(ascii, w, h, walls))
+		{
+			std::cerr << "cannot read " << ascii << "\n";
+			return 1;
+		}
+	}
+	else
+		walls = RandomWalls(w, h, density, seed);
+
+	auto start = Clock::now();
+	if (!LevelMap::Build(file, w, h, std::move(walls)))
+	{
+		std::cerr << "cannot build " << w << "x" << h << " level into " << file << "\n";
+		return 1;
+	}
+	std::cout << "  built " << w << "x" << h << " into " << file << " in " << std::setprecision(1)
+		<< Seconds(start) * 1e3 << " ms (walls, BFS fields, write)\n";
+
+	// Startup cost: map + header check only, then the optional full hash
+	auto level = std::make_shared<LevelMap>();
+	start = Clock::now();
+	const bool opened = level->Open(file);
+	const double openMs = Seconds(start) * 1e3;
+	if (!opened)
+	{
+		std::cerr << "cannot open " << file << "\n";
+		return 1;
+	}
+	start = Clock::now();
+	const bool verified = level->Verify();
+	const double verifyMs = Seconds(start) * 1e3;
+
+	const uint64_t cells = uint64_t(w) * uint64_t(h);
+	std::cout << "  open " << std::setprecision(3) << openMs << " ms for " << std::setprecision(2)
+		<< double(level->GetFileSize()) / (1 << 20) << " MB, verify " << verifyMs << " ms ("
+		<< (verified ? "ok" : "HASH MISMATCH") << "), " << level->GetOpenCount() << " / " << cells << " cells open\n";
+
+	uint64_t reachable = 0, maxDistance = 0, maxClearance = 0;
+	for (uint64_t i = 0; i < cells; ++i)
+	{
+		const uint16_t d = level->GetField(LevelField::FromSpawn)[i];
+		if (d == LevelMap::kUnreachable) continue;
+		++reachable;
+		maxDistance = std::max<uint64_t>(maxDistance, d);
+		maxClearance = std::max<uint64_t>(maxClearance, level->GetField(LevelField::ToWall)[i]);
+	}
+	std::cout << "  fields: " << reachable << " cells reachable from spawn (farthest " << maxDistance
+		<< " steps), widest clearance " << maxClearance << "\n";
+
+	// IsBlocked on random in-grid cells: level bit test vs open board
+	{
+		SnakeGame open(w, h), walled(level);
+		std::vector<Cell> probe(4096);
+		SnakeRng rng(seed + 1);
+		for (Cell& c : probe)
+			c = { int(rng.NextBelow(uint32_t(w))), int(rng.NextBelow(uint32_t(h))) };
+
+		int64_t sink = 0;
+		start = Clock::now();
+		for (int i = 0; i < queries; ++i) sink += open.IsBlocked(probe[size_t(i) & 4095]);
+		const double openSec = Seconds(start);
+		start = Clock::now();
+		for (int i = 0; i < queries; ++i) sink += walled.IsBlocked(probe[size_t(i) & 4095]);
+		const double walledSec = Seconds(start);
+
+		std::cout << "  IsBlocked: open board " << std::setprecision(2) << openSec / queries * 1e9 << " ns, level "
+			<< walledSec / queries * 1e9 << " ns per query (checksum " << sink << ")\n";
+	}
+
+	// One map behind every game of a parallel batch; nothing may ever
+	// stand on a wall
+	{
+		std::atomic<uint64_t> onWall(0);
+		WorkStealingPool pool(threads);
+
+		RunnerConfig config;
+		config.gridW = w;
+		config.gridH = h;
+		config.seedEnd = uint64_t(episodes);
+		config.starveSteps = 4 * (w + h);
+		config.grain = 1;
+		config.level = level;
+
+		const RunnerStats stats = RunEpisodes(pool, config, [&](const SnakeGame& game, SnakeRng& rng, int)
+			{
+				const Cell food = game.GetFood();
+				onWall.fetch_add(uint64_t(level->IsWall(game.GetHead())) + uint64_t(food.x >= 0 && level->IsWall(food)),
+					std::memory_order_relaxed);
+				return GreedyPolicy(game, rng);
+			});
+
+		std::cout << "  " << stats.episodes << " greedy episodes on " << pool.GetThreadCount()
+			<< " threads sharing the map: " << std::setprecision(1) << stats.steps / stats.seconds / 1e6
+			<< " M steps/s, mean score " << stats.MeanScore() << ", wall deaths "
+			<< stats.ends[int(EpisodeEnd::Wall)] << ", head/food on a wall " << onWall.load() << "\n";
+
+		return verified && onWall.load() == 0 ? 0 : 1;
+	}
+}
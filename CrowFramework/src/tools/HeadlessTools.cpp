@@ -0,0 +1,87 @@
+#include <tools/HeadlessTools.h>
+#include <tools/ToolArgs.h>
+#include <game/SnakeTypes.h>
+
+#include <cstring>
+#include <iostream>
+
+int BenchStep(const ToolArgs& args);
+int BenchRunner(const ToolArgs& args);
+int ReplayVerify(const ToolArgs& args);
+int BenchSnapshot(const ToolArgs& args);
+int BenchTT(const ToolArgs& args);
+int BenchAutopilot(const ToolArgs& args);
+int BenchFill(const ToolArgs& args);
+int BenchMcts(const ToolArgs& args);
+int SolveSmall(const ToolArgs& args);
+int BenchEnv(const ToolArgs& args);
+int BenchRaster(const ToolArgs& args);
+int TrainGa(const ToolArgs& args);
+int ArchiveGames(const ToolArgs& args);
+int BenchSparse(const ToolArgs& args);
+int BenchArena(const ToolArgs& args);
+int BenchPacked(const ToolArgs& args);
+int BuildLevel(const ToolArgs& args);
+
+struct HeadlessCommand
+{
+	const char* name;
+	int (*run)(const ToolArgs& args);
+	const char* help;
+};
+
+static const HeadlessCommand kCommands[] = {
+	{ "bench-step", &BenchStep, "game-steps/sec: SnakeGame vs variants vs SnakeBatch scalar/AVX2, then a lockstep cross-check of both kernels against SnakeGame [--games N --steps N --grid-w W --grid-h H --check-games N --check-steps N]" },
+	{ "bench-runner", &BenchRunner, "parallel greedy-policy episodes, speedup curve over thread counts [--episodes N --threads N --seed S]" },
+	{ "replay-verify", &ReplayVerify, "re-simulate a replay file, or record and re-check N games [--file F --expect-score N | --games N --save F]" },
+	{ "bench-snapshot", &BenchSnapshot, "SnakeGame clone cost: copy-construct vs snapshot save/restore, plus an arena DFS [--iters N --depth D]" },
+	{ "bench-tt", &BenchTT, "Zobrist hash check, DFS with/without a shared lock-free transposition table [--depth D --threads N --tt-log2 K]" },
+	{ "bench-autopilot", &BenchAutopilot, "autopilot decision latency and scores, then pool-wide autopilot episodes [--grid-w W --grid-h H --games N --episodes N]" },
+	{ "bench-fill", &BenchFill, "Hamiltonian solver fills the board; step cost by fill level [--grid-w W --grid-h H --games N --shortcut-limit F]" },
+	{ "bench-mcts", &BenchMcts, "parallel MCTS: rollouts/s and tree size per move, scaling over thread counts [--budget-ms MS --moves N --threads N]" },
+	{ "solve-small", &SolveSmall, "exact maximum score per seed on a small grid, next to autopilot and Hamiltonian scores [--grid-w W --grid-h H --seeds N --memo-log2 K]" },
+	{ "bench-env", &BenchEnv, "vectorized RL env: env-steps/s with observations and auto-reset into caller buffers, then a step-by-step check against SnakeGame [--envs N --steps N --threads N --check-envs N --check-steps N --check-threads N]" },
+	{ "bench-raster", &BenchRaster, "SnakeBatch boards to scaled uint8 images: images/s scalar vs AVX2, over thread counts [--games N --out-w W --out-h H --threads N]" },
+	{ "train-ga", &TrainGa, "evolve MLP policies: MLP forward scalar vs AVX2, generations/minute, core scaling [--generations N --population N --threads N --save snake_policy.bin]" },
+	{ "archive-games", &ArchiveGames, "record games into a memory-mapped replay archive, then random-seek and re-verify it on every core [--games N --file F --threads N]" },
+	{ "bench-sparse", &BenchSparse, "tiled sparse grid on boards up to 16384x16384: steps/s and memory next to the dense SnakeGame [--steps N --max-size N --dense-max N]" },
+	{ "bench-arena", &BenchArena, "many snakes on one grid: tick cost by snake count, region-parallel ticks checked against inline [--snakes N --ticks N --threads N]" },
+	{ "bench-packed", &BenchPacked, "2-bit direction-chain bodies: round trip against SnakeGame, bytes per body, move and decode rates [--games N --ops N]" },
+	{ "build-level", &BuildLevel, "write a wall map with BFS distance fields, time its mmap load and IsBlocked, run parallel games sharing it [--grid-w W --grid-h H --density F | --ascii F] [--file F --episodes N --threads N]" },
+};
+
+static void PrintUsage()
+{
+	std::cout << "Headless commands:\n";
+	for (const HeadlessCommand& cmd : kCommands)
+		std::cout << "  " << cmd.name << "  " << cmd.help << "\n";
+}
+
+int RunHeadlessCommand(int argc, char** argv)
+{
+	if (argc < 2) return -1;
+
+	if (std::strcmp(argv[1], "help") == 0 || std::strcmp(argv[1], "--help") == 0)
+	{
+		PrintUsage();
+		return 0;
+	}
+
+	for (const HeadlessCommand& cmd : kCommands)
+		if (std::strcmp(argv[1], cmd.name) == 0)
+		{
+			// Engines assert a playable grid; refuse bad sizes up front
+			const ToolArgs args(argc - 2, argv + 2);
+			const long long w = args.GetInt("--grid-w", 32), h = args.GetInt("--grid-h", 18);
+			if (w < 0 || h < 0 || w > 65535 || h > 65535 || !IsPlayableGrid(int(w), int(h)))
+			{
+				std::cout << "Unplayable grid " << w << "x" << h << ": need 4..4096 x 1..4096\n";
+				return 1;
+			}
+			return cmd.run(args);
+		}
+
+	std::cout << "Unknown command: " << argv[1] << "\n";
+	PrintUsage();
+	return 1;
+}
@@ -0,0 +1,131 @@
+#include <tools/ToolArgs.h>
+#include <tools/ToolPolicies.h>
+#include <game/SnakeGame.h>
+#include <game/SnakeReplay.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double Seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static const char* OutcomeName(const SnakeReplayResult& r)
+{
+	if (!r.gameOver) return "running";
+	if (r.won) return "won";
+	return r.deathCause == DeathCause::Wall ? "wall" : "self";
+}
+
+static int VerifyFile(const ToolArgs& args)
+{
+	const char* path = args.Get("--file", "");
+	SnakeReplay replay;
+	if (!replay.Load(path))
+	{
+		std::cout << "replay-verify: cannot read " << path << "\n";
+		return 1;
+	}
+
+	auto start = Clock::now();
+	const SnakeReplayResult r = SimulateReplay(replay);
+	const double sec = Seconds(start);
+
+	std::cout << "replay-verify: " << path << "  " << replay.GetGridW() << "x" << replay.GetGridH()
+		<< ", seed " << replay.GetSeed() << ", " << replay.GetStepCount() << " steps\n"
+		<< "  " << (r.valid ? "valid" : "INVALID") << ", score " << r.score << ", length " << r.length
+		<< ", end " << OutcomeName(r) << ", " << std::fixed << std::setprecision(3) << sec * 1e3 << " ms\n";
+
+	if (!r.valid) return 1;
+	if (args.Has("--expect-score") && r.score != int(args.GetInt("--expect-score", 0)))
+	{
+		std::cout << "  score mismatch: expected " << args.GetInt("--expect-score", 0) << "\n";
+		return 1;
+	}
+	return 0;
+}
+
+int ReplayVerify(const ToolArgs& args)
+{
+	if (args.Has("--file"))
+		return VerifyFile(args);
+
+	// Self-test: record games live, then re-simulate every log and compare
+	const int games = int(args.GetInt("--games", 200));
+	const int w = int(args.GetInt("--grid-w", 32));
+	const int h = int(args.GetInt("--grid-h", 18));
+	const uint64_t seed0 = uint64_t(args.GetInt("--seed", 1));
+
+	std::vector<SnakeReplay> replays(static_cast<size_t>(games));
+	std::vector<SnakeReplayResult> expected(static_cast<size_t>(games));
+
+	SnakeGame game(w, h);
+	uint64_t totalSteps = 0;
+	size_t totalBytes = 0;
+	size_t longest = 0;
+
+	for (int i = 0; i < games; ++i)
+	{
+		game.SetRecorder(&replays[i]);
+		game.Reset(seed0 + uint64_t(i));
+		SnakeRng policyRng = SnakeRng::ForStream(seed0 + uint64_t(i), 1);
+
+		// Starvation cap: greedy play can loop forever
+		for (int s = 0; !game.IsGameOver() && s < 200 * w * h; ++s)
+		{
+			game.SetPendingDir(GreedyPolicy(game, policyRng));
+			game.Tick();
+		}
+
+		SnakeReplayResult& e = expected[i];
+		e.steps = replays[i].GetStepCount();
+		e.score = game.GetScore();
+		e.length = game.GetLength();
+		e.gameOver = game.IsGameOver();
+		e.won = game.IsWon();
+		e.deathCause = game.GetDeathCause();
+
+		totalSteps += e.steps;
+		totalBytes += replays[i].GetPackedSize();
+		if (replays[i].GetStepCount() > replays[longest].GetStepCount())
+			longest = size_t(i);
+	}
+	game.SetRecorder(nullptr);
+
+	auto start = Clock::now();
+	int mismatches = 0;
+	for (int i = 0; i < games; ++i)
+	{
+		const SnakeReplayResult r = SimulateReplay(replays[i]);
+		const SnakeReplayResult& e = expected[i];
+		if (!r.valid || r.steps != e.steps || r.score != e.score || r.length != e.length ||
+			r.gameOver != e.gameOver || r.won != e.won || r.deathCause != e.deathCause)
+			mismatches++;
+	}
+	const double sec = Seconds(start);
+	const double gameTime = double(totalSteps) * game.GetStepTime();
+
+	std::cout << "replay-verify: " << games << " recorded games on " << w << "x" << h << "\n"
+		<< "  " << totalSteps << " steps in " << totalBytes << " bytes ("
+		<< std::fixed << std::setprecision(1) << double(totalBytes) * 100000.0 / double(totalSteps) / 1024.0
+		<< " KB per 100k steps)\n"
+		<< "  re-simulated in " << std::setprecision(3) << sec * 1e3 << " ms: "
+		<< std::setprecision(1) << double(totalSteps) / sec / 1e6 << " M steps/s, "
+		<< std::setprecision(0) << gameTime / sec << "x real time\n"
+		<< "  " << (mismatches ? "MISMATCH" : "all match") << " (" << mismatches << " of " << games << ")\n";
+
+	if (args.Has("--save") && games > 0)
+	{
+		const char* path = args.Get("--save", "");
+		const bool saved = replays[longest].Save(path);
+		std::cout << "  " << (saved ? "saved " : "could not save ") << path
+			<< " (" << replays[longest].GetStepCount() << " steps)\n";
+	}
+	return mismatches ? 1 : 0;
+}
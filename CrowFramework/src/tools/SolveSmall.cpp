@@ -0,0 +1,65 @@
+#include <tools/ToolArgs.h>
+#include <engine/WorkStealingPool.h>
+#include <game/HamiltonianSolver.h>
+#include <game/SnakeAutopilot.h>
+#include <game/SnakeGame.h>
+#include <game/SnakeSolver.h>
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+template <typename Bot>
+static int PlayOut(Bot& bot, int w, int h, uint64_t seed)
+{
+	// Starvation cap: a bot circling forever keeps its score
+	SnakeGame game(w, h, seed);
+	int hungry = 0;
+	int lastLength = game.GetLength();
+	while (!game.IsGameOver() && hungry < w * h * 4)
+	{
+		bot.Drive(game);
+		game.Tick();
+		hungry = game.GetLength() == lastLength ? hungry + 1 : 0;
+		lastLength = game.GetLength();
+	}
+	return game.GetScore();
+}
+
+int SolveSmall(const ToolArgs& args)
+{
+	const int w = int(args.GetInt("--grid-w", 4));
+	const int h = int(args.GetInt("--grid-h", 4));
+	const uint64_t seed = uint64_t(args.GetInt("--seed", 1));
+	const int seeds = int(args.GetInt("--seeds", 8));
+	const int threads = int(args.GetInt("--threads", WorkStealingPool::HardwareThreads()));
+	const int memoLog2 = int(args.GetInt("--memo-log2", 24));
+
+	WorkStealingPool pool(threads);
+	SnakeSolver solver(pool, memoLog2);
+	SnakeAutopilot autopilot(w, h);
+	HamiltonianSolver cycle(w, h);
+
+	std::cout << "solve-small: " << w << "x" << h << ", seeds " << seed << ".." << seed + uint64_t(seeds) - 1
+		<< ", " << pool.GetThreadCount() << " threads, memo 2^" << memoLog2 << " states\n";
+
+	int below = 0;
+	for (uint64_t s = seed; s < seed + uint64_t(seeds); ++s)
+	{
+		const SolveResult r = solver.Solve(SnakeGame(w, h, s));
+		const int pilotScore = PlayOut(autopilot, w, h, s);
+
+		std::cout << "  seed " << std::setw(4) << s << ": max " << std::setw(3) << r.maxScore << " of " << r.maxPossible
+			<< (r.proven ? " (proven)" : " (lower bound, memo full)") << ", " << std::setw(10) << r.states << " states, "
+			<< std::fixed << std::setprecision(2) << std::setw(7) << r.seconds << " s"
+			<< " | autopilot " << std::setw(3) << pilotScore;
+		if (cycle.IsSupported())
+			std::cout << ", hamiltonian " << std::setw(3) << PlayOut(cycle, w, h, s);
+		std::cout << "\n";
+
+		below += r.proven && pilotScore < r.maxScore;
+	}
+
+	std::cout << "  autopilot below the proven maximum on " << below << " of " << seeds << " seeds\n";
+	return 0;
+}
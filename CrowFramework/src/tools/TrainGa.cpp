@@ -0,0 +1,137 @@
+#include <tools/ToolArgs.h>
+#include <engine/WorkStealingPool.h>
+#include <game/SnakeEvolution.h>
+#include <game/SnakeMlp.h>
+#include <game/SnakeRng.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Batched forward throughput of one kernel; fills scores
+static double ForwardRowsPerSec(const SnakeMlp& mlp, const std::vector<float>& inputs, int batch,
+	std::vector<float>& scores, int rounds)
+{
+	SnakeMlpScratch scratch(batch);
+	auto start = Clock::now();
+	for (int r = 0; r < rounds; ++r)
+		mlp.Forward(inputs.data(), batch, scores.data(), scratch);
+	const double sec = std::chrono::duration<double>(Clock::now() - start).count();
+	return double(batch) * rounds / sec;
+}
+
+int TrainGa(const ToolArgs& args)
+{
+	EvolutionConfig config;
+	config.population = int(args.GetInt("--population", config.population));
+	config.gamesPerGenome = int(args.GetInt("--games", config.gamesPerGenome));
+	config.gridW = int(args.GetInt("--grid-w", config.gridW));
+	config.gridH = int(args.GetInt("--grid-h", config.gridH));
+	config.seed = uint64_t(args.GetInt("--seed", 1));
+	const int generations = int(args.GetInt("--generations", 40));
+	const int scalingGenerations = int(args.GetInt("--scaling-generations", 3));
+	const int maxThreads = int(args.GetInt("--threads", WorkStealingPool::HardwareThreads()));
+
+	// Inference kernels on random genomes and features
+	{
+		SnakeRng rng(5);
+		std::vector<float> params(size_t(SnakeMlp::GetParamCount()));
+		for (float& p : params)
+			p = rng.NextFloat() * 2.0f - 1.0f;
+
+		const int batch = 256;
+		std::vector<float> inputs(size_t(batch) * SnakeMlp::kInputs);
+		for (float& x : inputs)
+			x = rng.NextFloat();
+		std::vector<float> scalarScores(size_t(batch) * SnakeMlp::kOutputs), scores(scalarScores.size());
+
+		SnakeMlp mlp(params.data());
+		mlp.SetKernel(SnakeMlpKernel::Scalar);
+		const double scalarRate = ForwardRowsPerSec(mlp, inputs, batch, scalarScores, 2000);
+		std::cout << "train-ga: MLP " << SnakeMlp::kInputs << "-" << SnakeMlp::kHidden << "-" << SnakeMlp::kHidden
+			<< "-" << SnakeMlp::kOutputs << " (" << SnakeMlp::GetParamCount() << " params), batch " << batch << "\n"
+			<< std::fixed << std::setprecision(2)
+			<< "  forward scalar: " << scalarRate / 1e6 << " M rows/s\n";
+
+		mlp.SetKernel(SnakeMlpKernel::Auto);
+		if (mlp.GetKernel() == SnakeMlpKernel::Avx2)
+		{
+			const double rate = ForwardRowsPerSec(mlp, inputs, batch, scores, 2000);
+			std::cout << "  forward avx2:   " << rate / 1e6 << " M rows/s (" << rate / scalarRate << "x), scores "
+				<< (scores == scalarScores ? "match scalar" : "DIFFER from scalar") << "\n";
+		}
+		else
+			std::cout << "  AVX2 kernel unavailable, scalar only\n";
+	}
+
+	// Training run on every thread
+	double bestSeen = -1.0;
+	std::vector<float> best;
+	{
+		WorkStealingPool pool(maxThreads);
+		SnakeEvolution evolution(pool, config);
+
+		std::cout << "  training: population " << config.population << " x " << config.gamesPerGenome << " games on "
+			<< config.gridW << "x" << config.gridH << ", " << generations << " generations, " << pool.GetThreadCount() << " threads\n";
+
+		double seconds = 0.0;
+		for (int g = 0; g < generations; ++g)
+		{
+			const GenerationStats& s = evolution.RunGeneration();
+			seconds += s.seconds;
+			if (s.bestScore > bestSeen)
+			{
+				bestSeen = s.bestScore;
+				best = evolution.GetBest();
+			}
+
+			if (g % 5 == 0 || g + 1 == generations)
+				std::cout << "    gen " << std::setw(4) << s.generation << ": best fitness " << std::setw(6) << s.bestFitness
+					<< " (mean score " << std::setw(5) << s.bestScore << "), population mean " << std::setw(5) << s.meanFitness
+					<< ", max score " << std::setw(3) << s.maxScore << ", " << std::setw(6) << double(s.steps) / s.seconds / 1e6
+					<< " M steps/s\n";
+		}
+		std::cout << "  " << generations / seconds * 60.0 << " generations/minute\n";
+	}
+
+	// Core scaling: same seed, so every thread count breeds the same genomes
+	std::cout << "  scaling (" << scalingGenerations << " generations each):\n";
+	double baseRate = 0.0;
+	float baseFitness = 0.0f;
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		WorkStealingPool pool(threads);
+		SnakeEvolution evolution(pool, config);
+		double seconds = 0.0;
+		for (int g = 0; g < scalingGenerations; ++g)
+			seconds += evolution.RunGeneration().seconds;
+
+		const double rate = scalingGenerations / seconds * 60.0;
+		const float fitness = evolution.GetLastStats().bestFitness;
+		if (threads == 1)
+		{
+			baseRate = rate;
+			baseFitness = fitness;
+		}
+		std::cout << "    " << std::setw(2) << threads << " threads: " << std::setw(8) << rate << " generations/minute ("
+			<< rate / baseRate << "x)" << (fitness == baseFitness ? "" : ", results DIFFER from 1 thread") << "\n";
+	}
+	if (maxThreads < 2)
+		std::cout << "    (one hardware thread: pass --threads N to run more)\n";
+
+	if (args.Has("--save"))
+	{
+		const char* path = args.Get("--save", "");
+		SnakeMlp mlp(best.data());
+		const bool ok = mlp.Save(path);
+		std::cout << "  best genome (mean score " << bestSeen << ") " << (ok ? "saved to " : "could not be saved to ") << path << "\n";
+		if (!ok) return 1;
+	}
+	return 0;
+}